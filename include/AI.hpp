@@ -1,93 +1,71 @@
 #pragma once
 #include "Board.hpp"
+#include "Weights.hpp"
+#include "TranspositionTable.hpp"
+#include "MoveOrdering.hpp"
+#include "SearchStats.hpp"
+#include "ThreadPool.hpp"
+#include "Tablebase.hpp"
+#include "OpeningBook.hpp"
+#include "Trace.hpp"
 #include <iostream>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
-// wagi
-const int PIECE_VALUE = 100;
-const int KING_VALUE = 300;
-const int MOBILITY_WEIGHT = 5;
-const int ADVANCEMENT_WEIGHT = 3;
-const int CENTER_CONTROL_WEIGHT = 2;
-const int EDGE_PENALTY = -10;
-const int BACK_ROW_BONUS = 5;
-
-// tabela wag (w środku większe)
-const int POSITION_TABLE[8][8] = {
-    {0, 1, 0, 1, 0, 1, 0, 1},
-    {1, 0, 2, 0, 2, 0, 2, 0},
-    {0, 2, 0, 3, 0, 3, 0, 2},
-    {1, 0, 3, 0, 4, 0, 3, 0},
-    {0, 3, 0, 4, 0, 3, 0, 1},
-    {2, 0, 3, 0, 3, 0, 2, 0},
-    {0, 2, 0, 2, 0, 2, 0, 1},
-    {1, 0, 1, 0, 1, 0, 1, 0}
-};
+// wynik końca gry (z perspektywy wygrywającego); w przeszukiwaniu pomniejszany o odległość od korzenia,
+// więc szybsza wygrana (i wolniejsza przegrana) ma lepszy wynik
+const int WIN_SCORE = 10000;
+
+// od tej wartości bezwzględnej wynik to wygrana/przegrana w znanej liczbie ply (koniec gry w drzewie albo
+// odległość z bazy końcówek), a nie ocena heurystyczna (ta nie przekracza kilku tysięcy)
+const int KNOWN_WIN_SCORE = 8000;
+static_assert(WIN_SCORE - KNOWN_WIN_SCORE > MAX_PLY + TB_MAX_DISTANCE, "wygrana z bazy na końcu drzewa musi zostać wynikiem końca gry");
+
+// ocena statyczna pozycji, w której przeciwnik strony na ruchu nie ma ruchu: prawie pewna wygrana, ale nie
+// udowodniona (po naszym ruchu przeciwnik może go mieć), więc poniżej KNOWN_WIN_SCORE
+const int OPPONENT_BLOCKED_SCORE = 7000;
+
+inline int winIn(int ply) { return WIN_SCORE - ply; }
+inline int lossIn(int ply) { return -WIN_SCORE + ply; }
+
+// czy wynik to koniec gry w znanej liczbie ply (winIn/lossIn, także z bazy końcówek) - wtedy
+// WIN_SCORE - |score| to liczba ply od korzenia
+inline bool isGameEndScore(int score) { return std::abs(score) >= KNOWN_WIN_SCORE; }
+
+// Wyniki o znanej odległości są liczone od korzenia, a w tabeli transpozycji - od zapisywanej pozycji,
+// żeby wpis był poprawny także po dojściu do niej na innym ply.
+inline int scoreToTT(int score, int ply) {
+    if (score >= KNOWN_WIN_SCORE) return score + ply;
+    if (score <= -KNOWN_WIN_SCORE) return score - ply;
+    return score;
+}
+
+inline int scoreFromTT(int score, int ply) {
+    if (score >= KNOWN_WIN_SCORE) return score - ply;
+    if (score <= -KNOWN_WIN_SCORE) return score + ply;
+    return score;
+}
 
 // Funkcja oceniająca aktualny stan planszy
-inline int evaluateBoard(const Board& board) {
-    int score = 0;
-    int blackPieces = 0, whitePieces = 0;
-    int blackKings = 0, whiteKings = 0;
+inline int evaluateBoard(const Bitboard& board) {
+    // Punkty za pionki, damki, pozycję itd. - suma liczona na bieżąco przez Bitboard
+    int score = board.getStaticScore();
+    int blackPieces = popCount(board.getPieces<Piececolor::Black>());
+    int whitePieces = popCount(board.getPieces<Piececolor::White>());
+        
+    // Ocena mobilności (liczba możliwych ruchów, bez generowania listy)
+    int blackMoves = board.countMoves<Piececolor::Black>();
+    int whiteMoves = board.countMoves<Piececolor::White>();
     
-    // Liczenie punktów za pionki, damki, pozycję itd.
-    for (int row = 0; row < 8; ++row) {
-        for (int col = 0; col < 8; ++col) {
-            const Tile& tile = board.getTile(row, col);
-            if (tile.hasPiece()) {
-                const Piece* piece = tile.getPiece();
-                bool isBlack = (piece->getColor() == Piececolor::Black);
-                bool isKing = (piece->getType() == Piecetype::King);
-                
-                int pieceValue = isKing ? KING_VALUE : PIECE_VALUE;
-                
-                // Premia za pozycję na planszy
-                int positionBonus = POSITION_TABLE[row][col] * CENTER_CONTROL_WEIGHT;
-                
-                // Premia za przesunięcie pionka do przodu
-                int advancementBonus = 0;
-                if (!isKing) {
-                    if (isBlack) {
-                        advancementBonus = (7 - row) * ADVANCEMENT_WEIGHT;
-                    } else {
-                        advancementBonus = row * ADVANCEMENT_WEIGHT;
-                    }
-                }
-                
-                // Kara za pionki na krawędzi (jeśli nie są damkami)
-                int edgePenalty = 0;
-                if (!isKing && (col == 0 || col == 7)) {
-                    edgePenalty = EDGE_PENALTY;
-                }
-                
-                // Premia za ochronę ostatniego rzędu
-                int backRowBonus = 0;
-                if (!isKing) {
-                    if ((isBlack && row == 7) || (!isBlack && row == 0)) {
-                        backRowBonus = BACK_ROW_BONUS;
-                    }
-                }
-                
-                int totalValue = pieceValue + positionBonus + advancementBonus + edgePenalty + backRowBonus;
-                
-                if (isBlack) {
-                    score += totalValue;
-                    blackPieces++;
-                    if (isKing) blackKings++;
-                } else {
-                    score -= totalValue;
-                    whitePieces++;
-                    if (isKing) whiteKings++;
-                }
-            }
-        }
-    }
-    
-    // Ocena mobilności (liczba możliwych ruchów)
-    std::vector<Move> blackMoves = board.getAllValidMoves(Piececolor::Black);
-    std::vector<Move> whiteMoves = board.getAllValidMoves(Piececolor::White);
-    
-    score += (blackMoves.size() - whiteMoves.size()) * MOBILITY_WEIGHT;
+    score += (blackMoves - whiteMoves) * MOBILITY_WEIGHT;
     
     // Premia za przewagę liczebną w końcówce
     int totalPieces = blackPieces + whitePieces;
@@ -97,68 +75,831 @@ inline int evaluateBoard(const Board& board) {
     }
     
     // Sprawdzenie zwycięstwa/przegranej
-    if (blackPieces == 0) return -10000;
-    if (whitePieces == 0) return 10000;
-    if (blackMoves.empty()) return -10000;
-    if (whiteMoves.empty()) return 10000;
+    if (blackPieces == 0) return -WIN_SCORE;
+    if (whitePieces == 0) return WIN_SCORE;
+    if (blackMoves == 0) return -WIN_SCORE;
+    if (whiteMoves == 0) return WIN_SCORE;
     
     return score;
 }
 
-// Ulepszony minimax z alfa-beta pruning (opcjonalnie z tabelą transpozycji)
-inline int minimax(Board& board, int depth, int alpha, int beta, bool maximizingPlayer) {
-    Piececolor player = maximizingPlayer ? Piececolor::Black : Piececolor::White;
-    std::vector<Move> moves = board.getAllValidMoves(player);
+inline int evaluateBoard(const Board& board) {
+    return evaluateBoard(board.getBitboard());
+}
+
+// ocena z perspektywy strony Side (negamax) - zmiana znaku ustalona w czasie kompilacji.
+// Koniec gry (liczony od korzenia, ply) tylko wtedy, gdy to strona na ruchu nie ma ruchu;
+// zablokowany przeciwnik to tylko OPPONENT_BLOCKED_SCORE.
+template <Piececolor Side>
+inline int evaluate(const Bitboard& board, int ply) {
+    int score = evaluateBoard(board);
+    if constexpr (Side == Piececolor::White) score = -score;
+    if (std::abs(score) != WIN_SCORE) return score;
+    if (!board.hasAnyMove<Side>()) return lossIn(ply);
+    return (score > 0) ? OPPONENT_BLOCKED_SCORE : -OPPONENT_BLOCKED_SCORE;
+}
+
+// rozmiar domyślnej tabeli transpozycji (MB)
+const size_t DEFAULT_TT_SIZE_MB = 64;
+
+// tabela transpozycji współdzielona przez kolejne ruchy AI (zmiana rozmiaru: resize)
+inline TranspositionTable& aiTranspositionTable() {
+    static TranspositionTable table(DEFAULT_TT_SIZE_MB);
+    return table;
+}
+
+// maksymalna głębokość iteracyjnego pogłębiania
+const int MAX_SEARCH_DEPTH = 64;
+
+// wyszukiwanie spoczynkowe: domyślny limit ply i margines dla delta pruning
+const int DEFAULT_QUIESCENCE_PLY = 12;
+const int DELTA_MARGIN = 150;
+
+// górny limit wątków Lazy SMP
+const int MAX_SEARCH_THREADS = 64;
+
+// liczba wątków sprzętowych (co najmniej 1, najwyżej MAX_SEARCH_THREADS)
+inline int defaultSearchThreads() {
+    int n = static_cast<int>(std::thread::hardware_concurrency());
+    return std::clamp(n, 1, MAX_SEARCH_THREADS);
+}
+
+// sposób użycia wielu wątków (SearchLimits::threads > 1)
+enum class ParallelMode { LazySmp, RootSplit, Ybwc };
+
+// ograniczenia jednego przeszukiwania
+struct SearchLimits {
+    int maxDepth = MAX_SEARCH_DEPTH;
+    int timeLimitMs = 0;                        // 0 - bez limitu czasu
+    const std::atomic<bool>* cancel = nullptr;  // ustawione z innego wątku przerywa przeszukiwanie
+    int threads = 1;                            // 1 - jeden wątek, więcej - patrz parallelMode
+    ParallelMode parallelMode = ParallelMode::LazySmp;
+    int maxQuiescencePly = DEFAULT_QUIESCENCE_PLY;  // limit ply wyszukiwania spoczynkowego (0 - ocena od razu na głębokości 0)
+    bool useOpeningBook = false;                // ruch z księgi otwarć zamiast przeszukiwania (gra w oknie); narzędzia liczą zawsze
+    std::function<void(const SearchIteration&)> onIteration;  // wołane z wątku wywołującego findBestMove
+};
+
+// YBWC: węzły płytsze niż ta głębokość nie są dzielone między wątki (za mało pracy na narzut)
+const int YBWC_MIN_SPLIT_DEPTH = 4;
+
+/*
+SplitPoint - węzeł drzewa, którego pozostałe ruchy (po przeszukaniu najstarszego) liczy kilka wątków naraz
+co wie: pozycję, ruchy do wzięcia, wspólne okno alfa-beta i najlepszy wynik (pod mutex), liczbę pracujących
+pomocników, punkt podziału wyżej w drzewie (parent)
+aborted - cięcie beta w tym węźle; wątki pracujące gdzieś pod nim sprawdzają to w shouldStop i wracają
+*/
+struct SplitPoint {
+    std::mutex mutex;
+    Bitboard position;
+    MoveList moves;
+    PickStage stages[MoveList::MAX_MOVES];
+    int nextMove = 0;
+    int depth = 0;
+    int ply = 0;
+    Piececolor side = Piececolor::Black;  // strona na ruchu; alpha, beta i bestEval z jej perspektywy
+    int alpha = 0;
+    int beta = 0;
+    int bestEval = 0;
+    int bestMove = NO_MOVE;
+    int cutoffIndex = -1;
+    std::atomic<bool> aborted{false};
+    int helpers = 0;                          // pod mutex
+    std::condition_variable helpersDone;      // ostatni pomocnik budzi właściciela
+    SplitPoint* parent = nullptr;
 
-    // Koniec gry lub osiągnięta maksymalna głębokość
-    if (depth == 0 || moves.empty()) {
-        return evaluateBoard(board);
+    // czy zostały ruchy do wzięcia (wołane pod mutex)
+    bool hasWork() const { return !aborted.load(std::memory_order_relaxed) && nextMove < moves.size(); }
+};
+
+// wspólny stan wątków YBWC: otwarte punkty podziału i liczba wątków czekających na pracę
+struct YbwcShared {
+    std::mutex mutex;
+    std::condition_variable splitAvailable;
+    std::vector<SplitPoint*> openSplits;
+    std::atomic<int> idleThreads{0};
+    bool quit = false;
+};
+
+// stan jednego przeszukiwania: tabela transpozycji, limit czasu, licznik węzłów, heurystyki kolejności ruchów
+struct SearchContext {
+    TranspositionTable& tt;
+    std::chrono::steady_clock::time_point deadline;
+    bool hasDeadline = false;
+    const std::atomic<bool>* cancel = nullptr;
+    bool stopped = false;
+    SearchStats stats;            // liczniki tego wątku (sumowane po przeszukaniu)
+    std::atomic<uint64_t>* nodeCounter = nullptr;  // wspólny licznik węzłów wszystkich wątków (dodawane co 1024)
+    std::function<void(int depth, int score, const Move& bestMove)> onIteration;  // po ukończonej iteracji
+    int maxQuiescencePly = DEFAULT_QUIESCENCE_PLY;
+    OrderingTables ordering;
+    YbwcShared* ybwc = nullptr;   // ustawione - węzły mogą być dzielone między wątki
+    SplitPoint* split = nullptr;  // najgłębszy punkt podziału, nad którym ten wątek teraz pracuje
+
+    explicit SearchContext(TranspositionTable& tt) : tt(tt) {
+        ordering.clear();
+    }
+
+    // nowe przeszukiwanie z tymi samymi limitami co other (czas, anulowanie); liczniki stats zostają
+    void resetFrom(const SearchContext& other) {
+        deadline = other.deadline;
+        hasDeadline = other.hasDeadline;
+        cancel = other.cancel;
+        nodeCounter = other.nodeCounter;
+        maxQuiescencePly = other.maxQuiescencePly;
+        stopped = false;
+        ordering.clear();
+    }
+
+    // cięcie w którymś z punktów podziału nad tym wątkiem - jego praca jest już niepotrzebna
+    bool splitAborted() const {
+        for (const SplitPoint* sp = split; sp; sp = sp->parent) {
+            if (sp->aborted.load(std::memory_order_relaxed)) return true;
+        }
+        return false;
+    }
+
+    // czy przeszukiwanie trzeba teraz przerwać (czas, anulowanie, cięcie wyżej) - bez licznika węzłów
+    bool interrupted() const {
+        return (hasDeadline && std::chrono::steady_clock::now() >= deadline) ||
+               (cancel && cancel->load(std::memory_order_relaxed)) || splitAborted();
+    }
+
+    // co 1024 węzły sprawdza, czy nie skończył się czas albo czy przeszukiwanie nie zostało anulowane;
+    // cięcie w punkcie podziału sprawdzane w każdym węźle
+    bool shouldStop() {
+        if (!stopped && split && splitAborted()) stopped = true;
+        if (!stopped && (++stats.nodes & 1023) == 0) {
+            if (nodeCounter) nodeCounter->fetch_add(1024, std::memory_order_relaxed);
+            if ((hasDeadline && std::chrono::steady_clock::now() >= deadline) ||
+                (cancel && cancel->load(std::memory_order_relaxed))) {
+                stopped = true;
+            }
+        }
+        return stopped;
+    }
+};
+
+// ile materiału (w skali evaluateBoard) daje bicie strony Side: zbite pionki/damki i ewentualna promocja
+template <Piececolor Side>
+inline int captureGain(const Bitboard& board, const Move& move) {
+    uint32_t captured = move.getCapturedMask();
+    int capturedKings = popCount(captured & board.getKings());
+    int gain = capturedKings * KING_VALUE + (popCount(captured) - capturedKings) * PIECE_VALUE;
+    bool isMan = !(board.getKings() & squareBit(move.getFromSquare()));
+    if (isMan && move.getTo().row == promotionRow(Side)) {
+        gain += KING_VALUE - PIECE_VALUE;
+    }
+    return gain;
+}
+
+// Wyszukiwanie spoczynkowe: po głębokości 0 liczymy dalej, dopóki bicie jest obowiązkowe (qply - ply w tej fazie).
+// Pozycja bez bicia jest oceniana statycznie (stand pat). Bicia nie można odmówić, więc przy biciu ocena
+// statyczna służy tylko do delta pruning - pomijamy bicia, które nawet z marginesem nie zmienią wyniku.
+// Negamax: wynik z perspektywy strony Side (na ruchu).
+template <Piececolor Side>
+inline int quiescence(Bitboard& board, int ply, int qply, int alpha, int beta, SearchContext& ctx) {
+    if (ctx.shouldStop()) return 0;
+    ctx.stats.quiescenceNodes++;
+    ctx.stats.maxSelectiveDepth = std::max(ctx.stats.maxSelectiveDepth, ply);
+
+    MoveList captures;
+    board.addCaptureMoves<Side>(captures);
+    ctx.stats.moveGenerations++;
+
+    int standPat = evaluate<Side>(board, ply);
+    ctx.stats.evaluations++;
+    if (captures.empty() || qply >= ctx.maxQuiescencePly || ply >= MAX_PLY) {
+        return standPat;
+    }
+
+    int bestEval = -100000;
+    for (const Move& move : captures) {
+        int optimistic = standPat + captureGain<Side>(board, move) + DELTA_MARGIN;
+        if (optimistic <= alpha) {
+            bestEval = std::max(bestEval, optimistic);
+            continue;
+        }
+
+        UndoInfo undo = board.applyMove<Side>(move);
+        int eval = -quiescence<opponent(Side)>(board, ply + 1, qply + 1, -beta, -alpha, ctx);
+        board.undoMove<Side>(move, undo);
+        if (ctx.stopped) return 0;
+
+        bestEval = std::max(bestEval, eval);
+        alpha = std::max(alpha, eval);
+        if (alpha >= beta) break;
+    }
+    return bestEval;
+}
+
+template <Piececolor Side>
+inline void splitSearch(SplitPoint& sp, SearchContext& ctx);
+
+// wynik z bazy końcówek z perspektywy strony Side (na ruchu); false, gdy pozycji nie ma w bazie
+// Odległość z bazy to ply do końca gry, więc wynik jest na tej samej skali co koniec gry w drzewie -
+// szybsza wygrana wygrywa niezależnie od tego, czy znalazło ją przeszukiwanie, czy baza.
+template <Piececolor Side>
+inline bool probeTablebase(const Bitboard& board, int ply, int& score) {
+    TbProbe probe;
+    if (!endgameTablebase().probe(board, Side, probe)) return false;
+
+    score = 0;
+    if (probe.result == TbResult::Win) score = winIn(ply + probe.distance);
+    if (probe.result == TbResult::Loss) score = lossIn(ply + probe.distance);
+    return true;
+}
+
+// w śladzie (Trace.hpp) zapisywane są tylko węzły minimax z co najmniej taką pozostałą głębokością -
+// każdy obejmuje całą paczkę generowania ruchów i ocen swojego poddrzewa
+const int TRACE_MIN_DEPTH = 5;
+
+// Minimax w postaci negamax z alfa-beta pruning (PVS), tabelą transpozycji i sortowaniem ruchów
+// (ply - odległość od korzenia). Szablon po stronie na ruchu: wynik, okno (alpha, beta) i wpisy
+// w tabeli transpozycji są z perspektywy strony Side, a kolor nie jest sprawdzany w żadnym węźle.
+template <Piececolor Side>
+inline int negamax(Bitboard& board, int depth, int ply, int alpha, int beta, SearchContext& ctx) {
+    constexpr Piececolor Opponent = opponent(Side);
+    assert(board.getCurrentPlayer() == Side);
+    if (ctx.shouldStop()) return 0;
+    TraceScope trace("minimax", "search", "depth", depth, depth >= TRACE_MIN_DEPTH);
+
+    // Mate distance pruning: lepiej niż wygrana w następnym ruchu i gorzej niż przegrana tutaj być nie może -
+    // gdy już znaleziona wygrana jest szybsza, tej gałęzi nie trzeba liczyć
+    if (ply > 0) {
+        alpha = std::max(alpha, lossIn(ply));
+        beta = std::min(beta, winIn(ply + 1));
+        if (alpha >= beta) return alpha;
+    }
+
+    // Pozycja z bazy końcówek - dokładny wynik, dalej nie szukamy
+    int tablebaseScore;
+    if (ply > 0 && probeTablebase<Side>(board, ply, tablebaseScore)) {
+        ctx.stats.tablebaseHits++;
+        return tablebaseScore;
+    }
+
+    // Osiągnięta maksymalna głębokość - dokończenie wymuszonych bić
+    if (depth == 0) {
+        return quiescence<Side>(board, ply, 0, alpha, beta, ctx);
+    }
+
+    MoveList moves = board.getAllValidMoves<Side>();
+    ctx.stats.moveGenerations++;
+    ctx.stats.maxSelectiveDepth = std::max(ctx.stats.maxSelectiveDepth, ply);
+
+    // Koniec gry - strona bez ruchu przegrywa
+    if (moves.empty()) {
+        ctx.stats.evaluations++;
+        return lossIn(ply);
+    }
+
+    // Wynik z wcześniejszego przeszukania tej samej pozycji (klucz zawiera stronę na ruchu)
+    int alphaOrig = alpha;
+    int betaOrig = beta;
+    int hashMove = NO_MOVE;
+    TTEntry entry;
+    ctx.stats.ttProbes++;
+    if (ctx.tt.probe(board.getHash(), entry)) {
+        ctx.stats.ttHits++;
+        if (entry.depth >= depth) {
+            int ttScore = scoreFromTT(entry.score, ply);
+            if (entry.bound == Bound::Lower) alpha = std::max(alpha, ttScore);
+            if (entry.bound == Bound::Upper) beta = std::min(beta, ttScore);
+            if (entry.bound == Bound::Exact || beta <= alpha) {
+                ctx.stats.ttCutoffs++;
+                return ttScore;
+            }
+        }
+        if (entry.hasMove()) hashMove = moveKey(entry.moveFrom, entry.moveTo);
     }
 
     // Sortowanie ruchów dla lepszego cięcia alfa-beta
-    // Można dodać prostą эвристику сортировки
-    
-    if (maximizingPlayer) {
-        int maxEval = -100000;
-        for (const auto& move : moves) {
-            Board temp = board;
-            temp.applyMove(move);
-            int eval = minimax(temp, depth - 1, alpha, beta, false);
-            maxEval = std::max(maxEval, eval);
-            alpha = std::max(alpha, eval);
-            if (beta <= alpha) break; // a-b pruning
-        }
-        return maxEval;
-    } else {
-        int minEval = 100000;
-        for (const auto& move : moves) {
-            Board temp = board;
-            temp.applyMove(move);
-            int eval = minimax(temp, depth - 1, alpha, beta, true);
-            minEval = std::min(minEval, eval);
-            beta = std::min(beta, eval);
-            if (beta <= alpha) break; 
+    MovePicker picker(moves, hashMove, ctx.ordering, Side, ply);
+
+    int bestEval = -100000;
+    int bestMove = NO_MOVE;
+    int moveIndex = 0;
+    while (const Move* move = picker.next()) {
+        UndoInfo undo = board.applyMove<Side>(*move);
+        int eval;
+        if (moveIndex == 0) {
+            eval = -negamax<Opponent>(board, depth - 1, ply + 1, -beta, -alpha, ctx);
+        } else {
+            // PVS: najpierw okno zerowe - sprawdzamy tylko, czy ruch jest lepszy od dotychczasowego
+            eval = -negamax<Opponent>(board, depth - 1, ply + 1, -alpha - 1, -alpha, ctx);
+            if (eval > alpha && eval < beta) {
+                eval = -negamax<Opponent>(board, depth - 1, ply + 1, -beta, -alpha, ctx);
+            }
+        }
+        board.undoMove<Side>(*move, undo);
+        if (ctx.stopped) return 0;
+
+        if (eval > bestEval) {
+            bestEval = eval;
+            bestMove = moveKey(*move);
+        }
+        alpha = std::max(alpha, eval);
+
+        if (alpha >= beta) { // a-b pruning
+            ctx.ordering.recordCutoff(*move, Side, depth, ply);
+            ctx.stats.ordering.recordCutoff(moveIndex, picker.getStage());
+            break;
+        }
+        moveIndex++;
+
+        // YBWC: najstarszy brat przeszukany - resztę ruchów mogą wziąć wolne wątki
+        if (moveIndex == 1 && ctx.ybwc && depth >= YBWC_MIN_SPLIT_DEPTH && moves.size() > 2 &&
+            ctx.ybwc->idleThreads.load(std::memory_order_relaxed) > 0) {
+            SplitPoint sp;
+            sp.position = board;
+            while (const Move* rest = picker.next()) {
+                sp.stages[sp.moves.size()] = picker.getStage();
+                sp.moves.push_back(*rest);
+            }
+            sp.depth = depth;
+            sp.ply = ply;
+            sp.side = Side;
+            sp.alpha = alpha;
+            sp.beta = beta;
+            sp.bestEval = bestEval;
+            sp.bestMove = bestMove;
+            splitSearch<Side>(sp, ctx);
+            if (ctx.stopped) return 0;
+
+            bestEval = sp.bestEval;
+            bestMove = sp.bestMove;
+            if (sp.cutoffIndex >= 0) {
+                ctx.ordering.recordCutoff(sp.moves[sp.cutoffIndex], Side, depth, ply);
+                ctx.stats.ordering.recordCutoff(sp.cutoffIndex + 1, sp.stages[sp.cutoffIndex]);
+            }
+            break;
         }
-        return minEval;
     }
+
+    Bound bound = (bestEval <= alphaOrig) ? Bound::Upper : (bestEval >= betaOrig) ? Bound::Lower : Bound::Exact;
+    if (bestMove == NO_MOVE) bestMove = 0;
+    ctx.tt.store(board.getHash(), depth, scoreToTT(bestEval, ply), bound, bestMove / 32, bestMove % 32);
+    return bestEval;
 }
 
-\
-inline Move findBestMove(Board& board, int depth) {
-    std::vector<Move> moves = board.getAllValidMoves(Piececolor::Black);
-    if (moves.empty()) throw std::runtime_error("No moves for AI");
+// Minimax z perspektywy czarnych dla kodu spoza przeszukiwania (np. OpeningBookGen):
+// kolor wybierany raz, dalej negamax
+inline int minimax(Bitboard& board, int depth, int ply, int alpha, int beta, bool maximizingPlayer, SearchContext& ctx) {
+    if (maximizingPlayer) return negamax<Piececolor::Black>(board, depth, ply, alpha, beta, ctx);
+    return -negamax<Piececolor::White>(board, depth, ply, -beta, -alpha, ctx);
+}
+
+// Praca nad punktem podziału (właściciel i pomocnicy): bierze kolejne ruchy, przeszukuje je w aktualnym
+// wspólnym oknie (PVS) i odkłada wynik. Cięcie beta ustawia aborted - pozostali kończą swoje poddrzewa.
+template <Piececolor Side>
+inline void workOnSplit(SplitPoint& sp, SearchContext& ctx) {
+    constexpr Piececolor Opponent = opponent(Side);
+    SplitPoint* previous = ctx.split;
+    ctx.split = &sp;
+    Bitboard board = sp.position;
+
+    while (true) {
+        int index, alpha, beta;
+        {
+            std::lock_guard<std::mutex> lock(sp.mutex);
+            if (!sp.hasWork()) break;
+            index = sp.nextMove++;
+            alpha = sp.alpha;
+            beta = sp.beta;
+        }
+
+        const Move& move = sp.moves[index];
+        UndoInfo undo = board.applyMove<Side>(move);
+        int eval = -negamax<Opponent>(board, sp.depth - 1, sp.ply + 1, -alpha - 1, -alpha, ctx);
+        if (eval > alpha && eval < beta) {
+            eval = -negamax<Opponent>(board, sp.depth - 1, sp.ply + 1, -beta, -alpha, ctx);
+        }
+        board.undoMove<Side>(move, undo);
+        if (ctx.stopped) break;
+
+        std::lock_guard<std::mutex> lock(sp.mutex);
+        if (sp.aborted) break;
+        if (eval > sp.bestEval) {
+            sp.bestEval = eval;
+            sp.bestMove = moveKey(move);
+        }
+        sp.alpha = std::max(sp.alpha, eval);
+        if (sp.alpha >= sp.beta) {
+            sp.cutoffIndex = index;
+            sp.aborted = true;
+        }
+    }
+
+    // przerwanie tego punktu podziału nie przerywa pracy wyżej w drzewie
+    ctx.split = previous;
+    ctx.stopped = ctx.interrupted();
+}
+
+// pomocnik nie zna strony na ruchu w punkcie podziału z góry - wybiera szablon raz na punkt
+inline void workOnSplit(SplitPoint& sp, SearchContext& ctx) {
+    if (sp.side == Piececolor::Black) workOnSplit<Piececolor::Black>(sp, ctx);
+    else workOnSplit<Piececolor::White>(sp, ctx);
+}
+
+// Właściciel punktu podziału: udostępnia go wolnym wątkom, sam też bierze ruchy, a na koniec zamyka
+// punkt i czeka, aż pomocnicy skończą swoje poddrzewa.
+template <Piececolor Side>
+inline void splitSearch(SplitPoint& sp, SearchContext& ctx) {
+    YbwcShared& shared = *ctx.ybwc;
+    sp.parent = ctx.split;
+    {
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        shared.openSplits.push_back(&sp);
+    }
+    shared.splitAvailable.notify_all();
+
+    workOnSplit<Side>(sp, ctx);
+
+    {
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        shared.openSplits.erase(std::find(shared.openSplits.begin(), shared.openSplits.end(), &sp));
+    }
+    std::unique_lock<std::mutex> lock(sp.mutex);
+    sp.helpersDone.wait(lock, [&sp]() { return sp.helpers == 0; });
+}
 
+// Pętla wątku pomocniczego YBWC: czeka na otwarty punkt podziału z wolnymi ruchami i dołącza do niego.
+inline void ybwcHelperLoop(YbwcShared& shared, SearchContext& ctx) {
+    setTraceThreadName("pomocnik YBWC");
+    std::unique_lock<std::mutex> lock(shared.mutex);
+    while (true) {
+        SplitPoint* found = nullptr;
+        for (SplitPoint* sp : shared.openSplits) {
+            std::lock_guard<std::mutex> spLock(sp->mutex);
+            if (sp->hasWork()) {
+                // punkt jest na liście, więc właściciel jeszcze na niego nie czeka - można się zapisać
+                sp->helpers++;
+                found = sp;
+                break;
+            }
+        }
+        if (!found) {
+            if (shared.quit) return;
+            shared.idleThreads++;
+            TraceScope parked("park", "threads");
+            shared.splitAvailable.wait(lock);
+            shared.idleThreads--;
+            continue;
+        }
+
+        lock.unlock();
+        workOnSplit(*found, ctx);
+        {
+            // powiadomienie pod mutex: po przebudzeniu właściciel od razu niszczy punkt podziału
+            std::lock_guard<std::mutex> spLock(found->mutex);
+            if (--found->helpers == 0) found->helpersDone.notify_one();
+        }
+        lock.lock();
+    }
+}
+
+// połowa szerokości okna aspiracji wokół wyniku poprzedniej iteracji
+const int ASPIRATION_WINDOW = 50;
+
+// Przeszukanie korzenia (czarne na ruchu) w oknie (alpha, beta); bestIndex - indeks najlepszego ruchu
+inline int searchRoot(Bitboard& root, MoveList& moves, int depth, int alpha, int beta,
+                      SearchContext& ctx, int& bestIndex) {
     int bestValue = -100000;
-    Move bestMove = moves.front();
-    
-    for (const auto& move : moves) {
-        Board temp = board;
-        temp.applyMove(move);
-        int value = minimax(temp, depth - 1, -100000, 100000, false);
+    bestIndex = 0;
+
+    for (int i = 0; i < moves.size(); ++i) {
+        TraceScope trace("root move", "search", "move", moveKey(moves[i]));
+        UndoInfo undo = root.applyMove<Piececolor::Black>(moves[i]);
+        int value;
+        if (i == 0) {
+            value = -negamax<Piececolor::White>(root, depth - 1, 1, -beta, -alpha, ctx);
+        } else {
+            value = -negamax<Piececolor::White>(root, depth - 1, 1, -alpha - 1, -alpha, ctx);
+            if (value > alpha && value < beta) {
+                value = -negamax<Piececolor::White>(root, depth - 1, 1, -beta, -alpha, ctx);
+            }
+        }
+        root.undoMove<Piececolor::Black>(moves[i], undo);
+        if (ctx.stopped) break;
+
         if (value > bestValue) {
             bestValue = value;
-            bestMove = move;
+            bestIndex = i;
         }
+        alpha = std::max(alpha, value);
+        if (alpha >= beta) break;
+    }
+    return bestValue;
+}
+
+// Iteracyjne pogłębianie: głębokość firstDepth, firstDepth + 1... aż do maxDepth albo do przerwania (ctx.stopped).
+// Zwraca najlepszy ruch z ostatniej pełnej iteracji; ten ruch jest sprawdzany jako pierwszy w następnej.
+// Od głębokości 3 korzeń jest przeszukiwany w oknie aspiracji wokół poprzedniego wyniku (o ile useAspiration).
+// searchIteration(depth, alpha, beta, bestIndex) przeszukuje korzeń - domyślnie searchRoot.
+template <typename RootSearch>
+inline Move iterativeDeepening(MoveList& moves, int firstDepth, int maxDepth, bool useAspiration,
+                               SearchContext& ctx, RootSearch searchIteration) {
+    Move bestMove = moves.front();
+    int previousValue = 0;
+    for (int depth = firstDepth; depth <= maxDepth; ++depth) {
+        TraceScope trace("iteration", "search", "depth", depth);
+        bool aspiration = useAspiration && depth >= 3 && depth > firstDepth;
+        int delta = ASPIRATION_WINDOW;
+        int alpha = aspiration ? previousValue - delta : -100000;
+        int beta = aspiration ? previousValue + delta : 100000;
+        int value = 0;
+        int bestIndex = 0;
+
+        while (true) {
+            value = searchIteration(depth, alpha, beta, bestIndex);
+            if (ctx.stopped) break;
+
+            // wynik poza oknem - poszerzamy okno i szukamy jeszcze raz
+            delta *= 4;
+            if (value <= alpha && alpha > -100000) {
+                alpha = std::max(-100000, value - delta);
+            } else if (value >= beta && beta < 100000) {
+                beta = std::min(100000, value + delta);
+            } else {
+                break;
+            }
+        }
+        // przerwana iteracja się nie liczy
+        if (ctx.stopped) break;
+
+        previousValue = value;
+        bestMove = moves[bestIndex];
+        std::rotate(moves.begin(), moves.begin() + bestIndex, moves.begin() + bestIndex + 1);
+        if (ctx.onIteration) ctx.onIteration(depth, value, bestMove);
+
+        // wygrana albo przegrana w zasięgu pełnej głębokości jest już najszybsza - głębiej nic się nie zmieni
+        // (wyniki winIn/lossIn powstają tylko w pozycjach, w których strona na ruchu naprawdę nie ma ruchu)
+        if (isGameEndScore(value) && std::abs(value) >= winIn(depth)) break;
     }
     return bestMove;
-}
\ No newline at end of file
+}
+
+inline Move iterativeDeepening(Bitboard& root, MoveList& moves, int firstDepth, int maxDepth, SearchContext& ctx) {
+    return iterativeDeepening(moves, firstDepth, maxDepth, true, ctx, [&](int depth, int alpha, int beta, int& bestIndex) {
+        return searchRoot(root, moves, depth, alpha, beta, ctx, bestIndex);
+    });
+}
+
+// rozmiar prywatnej tabeli transpozycji każdego wątku przy podziale korzenia (MB)
+const size_t ROOT_SPLIT_TT_SIZE_MB = 4;
+
+/*
+RootSplitWorker - stan jednego wątku przy podziale korzenia
+co wie: własną tabelę transpozycji i własny SearchContext
+co umie: czyści się przed każdym przeszukaniem, żeby jego wynik nie zależał od wcześniejszych zadań
+*/
+struct RootSplitWorker {
+    TranspositionTable tt{ROOT_SPLIT_TT_SIZE_MB};
+    SearchContext ctx{tt};
+
+    SearchContext& restart(const SearchContext& limits) {
+        tt.clear();
+        ctx.resetFrom(limits);
+        return ctx;
+    }
+};
+
+// wynik ruchu w korzeniu razem z jego indeksem (w jednym słowie dla atomowego maksimum):
+// lepszy jest większy wynik, a przy remisie mniejszy indeks
+inline uint64_t packRootScore(int value, int index) {
+    return (static_cast<uint64_t>(value + 1000000) << 16) | static_cast<uint64_t>(0xFFFF - index);
+}
+inline int rootScoreValue(uint64_t packed) { return static_cast<int>(packed >> 16) - 1000000; }
+inline int rootScoreIndex(uint64_t packed) { return 0xFFFF - static_cast<int>(packed & 0xFFFF); }
+
+// Jedna iteracja z podziałem korzenia: pierwszy ruch w pełnym oknie na wątku wywołującym (workers.back()),
+// pozostałe jako osobne zadania puli. Zadania dzielą najlepszy dotychczasowy wynik (alfa) - każde najpierw
+// sprawdza oknem zerowym, czy jego ruch go pobija, i dopiero wtedy liczy dokładny wynik.
+// Determinizm: każde zadanie zaczyna od wyczyszczonych tablic, dokładny wynik liczony jest zawsze w oknie
+// (wynik pierwszego ruchu, +inf), a remisy rozstrzyga kolejność ruchów - nie kolejność kończenia zadań.
+inline int searchRootSplit(const Bitboard& root, const MoveList& moves, int depth, SearchContext& ctx,
+                           ThreadPool& pool, std::vector<std::unique_ptr<RootSplitWorker>>& workers, int& bestIndex) {
+    bestIndex = 0;
+    SearchContext& first = workers.back()->restart(ctx);
+    Bitboard firstChild = root;
+    firstChild.applyMove<Piececolor::Black>(moves[0]);
+    int firstValue;
+    {
+        TraceScope trace("root move", "search", "move", moveKey(moves[0]));
+        firstValue = -negamax<Piececolor::White>(firstChild, depth - 1, 1, -100000, 100000, first);
+    }
+    if (first.stopped) {
+        ctx.stopped = true;
+        return 0;
+    }
+
+    std::atomic<uint64_t> best{packRootScore(firstValue, 0)};
+    std::atomic<bool> anyStopped{false};
+    for (int i = 1; i < moves.size(); ++i) {
+        pool.submit([&, i](int workerIndex) {
+            TraceScope trace("root move", "search", "move", moveKey(moves[i]));
+            RootSplitWorker& worker = *workers[workerIndex];
+            Bitboard child = root;
+            child.applyMove<Piececolor::Black>(moves[i]);
+
+            // czy ruch pobija aktualnie najlepszy (przy remisie wygrywa mniejszy indeks)?
+            uint64_t current = best.load();
+            int threshold = rootScoreValue(current) - (i < rootScoreIndex(current) ? 1 : 0);
+            SearchContext& probe = worker.restart(ctx);
+            int value = -negamax<Piececolor::White>(child, depth - 1, 1, -threshold - 1, -threshold, probe);
+            if (!probe.stopped && value > threshold) {
+                SearchContext& exact = worker.restart(ctx);
+                value = -negamax<Piececolor::White>(child, depth - 1, 1, -100000, -firstValue, exact);
+                if (!exact.stopped && value > firstValue) {
+                    uint64_t packed = packRootScore(value, i);
+                    while (packed > current && !best.compare_exchange_weak(current, packed)) {}
+                }
+            }
+            if (worker.ctx.stopped) anyStopped = true;
+        });
+    }
+    pool.wait();
+
+    if (anyStopped) {
+        ctx.stopped = true;
+        return 0;
+    }
+    bestIndex = rootScoreIndex(best.load());
+    return rootScoreValue(best.load());
+}
+
+// wynik przeszukiwania: ruch, jego ocena (z perspektywy czarnych), główny wariant i liczniki
+struct SearchResult {
+    Move bestMove;
+    int score = 0;
+    std::vector<Move> principalVariation;  // zaczyna się od bestMove
+    SearchStats stats;
+};
+
+// kontekst wątku wywołującego findBestMove: limity z SearchLimits, wspólny licznik węzłów, raport po iteracji
+inline void configureMainContext(SearchContext& ctx, const SearchLimits& limits,
+                                 std::chrono::steady_clock::time_point startTime, std::atomic<uint64_t>& nodeCounter,
+                                 SearchStats& result) {
+    ctx.cancel = limits.cancel;
+    ctx.maxQuiescencePly = std::clamp(limits.maxQuiescencePly, 0, MAX_PLY);
+    if (limits.timeLimitMs > 0) {
+        ctx.hasDeadline = true;
+        ctx.deadline = startTime + std::chrono::milliseconds(limits.timeLimitMs);
+    }
+    ctx.nodeCounter = &nodeCounter;
+    ctx.onIteration = [&limits, &ctx, &nodeCounter, &result, startTime](int depth, int score, const Move& bestMove) {
+        SearchIteration iteration;
+        iteration.depth = depth;
+        iteration.score = score;
+        iteration.bestMove = bestMove;
+        // reszta węzłów wątku głównego, której nie dodał jeszcze do wspólnego licznika
+        iteration.nodes = nodeCounter.load(std::memory_order_relaxed) + (ctx.stats.nodes & 1023);
+        iteration.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+        result.iterations.push_back(iteration);
+        // paczki generowania ruchów i ocen - liczniki wątku głównego
+        if (traceEnabled()) {
+            traceCounter("nodes", static_cast<int64_t>(iteration.nodes));
+            traceCounter("move generations", static_cast<int64_t>(ctx.stats.moveGenerations));
+            traceCounter("evaluations", static_cast<int64_t>(ctx.stats.evaluations));
+        }
+        if (limits.onIteration) limits.onIteration(iteration);
+    };
+}
+
+// Główny wariant z tabeli transpozycji: bestMove, a dalej zapisane najlepsze ruchy, dopóki są legalne
+// (przy ParallelMode::RootSplit wątki mają prywatne tabele, więc zwykle zostaje sam bestMove).
+inline std::vector<Move> principalVariation(const Bitboard& root, const Move& bestMove, TranspositionTable& tt,
+                                            int maxLength) {
+    std::vector<Move> pv{bestMove};
+    Bitboard board = root;
+    board.applyMove(bestMove);
+    std::vector<uint64_t> seen{root.getHash()};
+
+    TTEntry entry;
+    while (static_cast<int>(pv.size()) < maxLength && tt.probe(board.getHash(), entry) && entry.hasMove()) {
+        if (std::find(seen.begin(), seen.end(), board.getHash()) != seen.end()) break;
+        seen.push_back(board.getHash());
+
+        MoveList moves = board.getAllValidMoves(board.getCurrentPlayer());
+        const Move* next = std::find_if(moves.begin(), moves.end(), [&](const Move& move) {
+            return move.getFromSquare() == entry.moveFrom && move.getToSquare() == entry.moveTo;
+        });
+        if (next == moves.end()) break;
+        pv.push_back(*next);
+        board.applyMove(*next);
+    }
+    return pv;
+}
+
+// Najlepszy ruch czarnych w granicach SearchLimits razem z głównym wariantem i licznikami wszystkich wątków;
+// pozycje z książki debiutowej nie są przeszukiwane.
+// Przy limits.threads > 1 (Lazy SMP) wątki pomocnicze liczą to samo iteracyjne pogłębianie na własnych
+// kopiach pozycji i dzielą się wynikami tylko przez wspólną tabelę transpozycji. Żeby nie powtarzały
+// pracy wątku głównego, co drugi zaczyna o jedną głębokość wyżej, a każdy zaczyna od innego ruchu w korzeniu.
+// Wynik zwraca wątek główny; gdy skończy (albo zostanie przerwany), pomocnicze są zatrzymywane.
+// Przy ParallelMode::Ybwc pomocnicy czekają na punkty podziału w minimax (splitSearch) - dzielone są węzły
+// na dowolnej głębokości, również przy kilku wymuszonych biciach w korzeniu.
+// Przy ParallelMode::RootSplit ruchy w korzeniu są rozdzielane między wątki puli (searchRootSplit) -
+// wynik jest powtarzalny dla tej samej pozycji i głębokości, ale wspólna tabela transpozycji nie jest używana.
+inline SearchResult searchBestMove(const Bitboard& position, const SearchLimits& limits) {
+    TraceScope trace("findBestMove", "search", "threads", limits.threads);
+    auto startTime = std::chrono::steady_clock::now();
+    SearchResult result;
+
+    // wyszukiwanie działa na kopii pozycji, AI gra czarnymi
+    Bitboard root = position;
+    root.setCurrentPlayer(Piececolor::Black);
+    MoveList moves = root.getAllValidMoves(Piececolor::Black);
+    if (moves.empty()) throw std::runtime_error("No moves for AI");
+    if (moves.size() == 1 || (limits.useOpeningBook && openingBook().probe(root, result.bestMove))) {
+        if (moves.size() == 1) result.bestMove = moves.front();
+        result.principalVariation.push_back(result.bestMove);
+        return result;
+    }
+
+    TranspositionTable& tt = aiTranspositionTable();
+    int maxDepth = std::min(limits.maxDepth, MAX_SEARCH_DEPTH);
+    int threads = std::clamp(limits.threads, 1, MAX_SEARCH_THREADS);
+    std::atomic<uint64_t> nodeCounter{0};
+    SearchStats& stats = result.stats;
+    SearchContext ctx(tt);
+    configureMainContext(ctx, limits, startTime, nodeCounter, stats);
+
+    // konteksty pozostałych wątków; ich liczniki są sumowane na koniec
+    std::vector<std::unique_ptr<SearchContext>> helperContexts;
+
+    if (threads > 1 && limits.parallelMode == ParallelMode::RootSplit) {
+        // stany wątków puli + wątku wywołującego (ostatni), który liczy pierwszy ruch i czeka na resztę
+        ThreadPool pool(threads);
+        std::vector<std::unique_ptr<RootSplitWorker>> workers;
+        for (int i = 0; i <= threads; ++i) workers.push_back(std::make_unique<RootSplitWorker>());
+
+        result.bestMove = iterativeDeepening(moves, 1, maxDepth, false, ctx,
+            [&](int depth, int, int, int& bestIndex) {
+                return searchRootSplit(root, moves, depth, ctx, pool, workers, bestIndex);
+            });
+        for (auto& worker : workers) stats.merge(worker->ctx.stats);
+    } else if (threads > 1 && limits.parallelMode == ParallelMode::Ybwc) {
+        YbwcShared shared;
+        ctx.ybwc = &shared;
+
+        std::vector<std::thread> helpers;
+        for (int i = 1; i < threads; ++i) {
+            helperContexts.push_back(std::make_unique<SearchContext>(tt));
+            helperContexts.back()->resetFrom(ctx);
+            helperContexts.back()->ybwc = &shared;
+        }
+        for (auto& helperContext : helperContexts) {
+            helpers.emplace_back(ybwcHelperLoop, std::ref(shared), std::ref(*helperContext));
+        }
+
+        result.bestMove = iterativeDeepening(root, moves, 1, maxDepth, ctx);
+        {
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            shared.quit = true;
+        }
+        shared.splitAvailable.notify_all();
+        for (std::thread& helper : helpers) helper.join();
+    } else {
+        // każdy pomocnik dostaje własną kopię pozycji i listy ruchów (wątek główny je zmienia)
+        std::atomic<bool> helpersStop{false};
+        std::vector<std::thread> helpers;
+        for (int i = 1; i < threads; ++i) {
+            helperContexts.push_back(std::make_unique<SearchContext>(tt));
+            SearchContext& helperContext = *helperContexts.back();
+            helperContext.cancel = &helpersStop;
+            helperContext.nodeCounter = &nodeCounter;
+            helperContext.maxQuiescencePly = ctx.maxQuiescencePly;
+            helpers.emplace_back([root, moves, &helperContext, maxDepth, i]() mutable {
+                setTraceThreadName("pomocnik Lazy SMP");
+                std::rotate(moves.begin(), moves.begin() + i % moves.size(), moves.end());
+                iterativeDeepening(root, moves, 1 + (i & 1), maxDepth, helperContext);
+            });
+        }
+
+        result.bestMove = iterativeDeepening(root, moves, 1, maxDepth, ctx);
+
+        helpersStop = true;
+        for (std::thread& helper : helpers) helper.join();
+    }
+
+    stats.merge(ctx.stats);
+    for (auto& helperContext : helperContexts) stats.merge(helperContext->stats);
+    stats.threads = threads;
+    stats.timeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    result.score = stats.iterations.empty() ? 0 : stats.iterations.back().score;
+    result.principalVariation = principalVariation(root, result.bestMove, tt, std::max(stats.depth(), 1));
+    return result;
+}
+
+inline Move findBestMove(const Bitboard& position, const SearchLimits& limits) {
+    return searchBestMove(position, limits).bestMove;
+}
+
+inline Move findBestMove(Board& board, int maxDepth, int timeLimitMs = 0, int threads = 1) {
+    SearchLimits limits;
+    limits.maxDepth = maxDepth;
+    limits.timeLimitMs = timeLimitMs;
+    limits.threads = threads;
+    return findBestMove(board.getBitboard(), limits);
+}
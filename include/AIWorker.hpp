@@ -0,0 +1,35 @@
+#ifndef AIWORKER_H
+#define AIWORKER_H
+
+#include "AI.hpp"
+#include <atomic>
+#include <future>
+#include <optional>
+
+/*
+AIWorker - liczy ruch AI w osobnym wątku, żeby okno SFML dalej się rysowało
+co wie: trwające wyszukiwanie (future z wynikiem i statystykami) i flagę anulowania
+co umie:
+    * startuje wyszukiwanie na kopii pozycji
+    * sprawdza bez blokowania, czy ruch jest gotowy (wołane co klatkę)
+    * anuluje wyszukiwanie (np. powrót do menu) - wynik jest wtedy odrzucany
+Naraz liczy się tylko jedno wyszukiwanie, bo wszystkie korzystają z tej samej tabeli transpozycji.
+*/
+class AIWorker {
+private:
+    std::future<SearchResult> pending;
+    std::atomic<bool> cancelRequested{false};
+
+public:
+    AIWorker() = default;
+    AIWorker(const AIWorker&) = delete;
+    AIWorker& operator=(const AIWorker&) = delete;
+    ~AIWorker();
+
+    void start(const Bitboard& snapshot, int maxDepth, int timeLimitMs, int threads = 1);
+    std::optional<SearchResult> poll();
+    void cancel();
+    bool isThinking() const { return pending.valid(); }
+};
+
+#endif
@@ -0,0 +1,226 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include "Piece.hpp"
+#include "Move.hpp"
+#include "Weights.hpp"
+#include <cassert>
+#include <cstdint>
+#include <optional>
+
+/*
+Bitboard - pozycja zapisana na maskach bitowych (tylko 32 ciemne pola)
+co wie: maska białych, maska czarnych, maska damek; kto jest na ruchu; klucz Zobrista;
+    suma statycznych wartości pionków (PIECE_SQUARE_SCORES)
+co umie:
+    * ustawia pozycję początkową
+    * stawia/usuwa pionek, robi damkę
+    * zwraca wszystkie możliwe ruchy dla gracza (przesunięcia masek dla pionków, promienie dla damek)
+    * liczy ruchy i sprawdza, czy gracz ma jakikolwiek ruch - same operacje na maskach, bez obiektów Move
+    * zastosować ruch i cofnąć go (make/unmake)
+Generator ruchów i make/unmake są też szablonami po kolorze gracza (np. addCaptureMoves<Piececolor::Black>) -
+kierunek ruchu pionków, rząd promocji i maski stron są wtedy stałymi czasu kompilacji. Wersje z kolorem
+w argumencie wybierają szablon raz, na wejściu.
+Numeracja pól - patrz squareIndex w Move.hpp
+*/
+
+constexpr Piececolor opponent(Piececolor color) {
+    return (color == Piececolor::White) ? Piececolor::Black : Piececolor::White;
+}
+
+// kierunki: 0 = góra-lewo, 1 = góra-prawo, 2 = dół-lewo, 3 = dół-prawo (dół = w stronę rzędu 7)
+constexpr int DIR_ROW[4] = {-1, -1, 1, 1};
+constexpr int DIR_COL[4] = {-1, 1, -1, 1};
+
+// pierwszy z dwóch kierunków ruchu pionka (białe idą w górę, czarne w dół) i rząd promocji
+constexpr int manFirstDirection(Piececolor color) {
+    return (color == Piececolor::White) ? 0 : 2;
+}
+
+constexpr int promotionRow(Piececolor color) {
+    return (color == Piececolor::White) ? 0 : 7;
+}
+
+inline int oppositeDirection(int dir) {
+    return 3 - dir;
+}
+
+const uint32_t EVEN_ROWS = 0x0F0F0F0Fu;  // rzędy 0, 2, 4, 6 (kolumny 1, 3, 5, 7)
+const uint32_t ODD_ROWS = 0xF0F0F0F0u;   // rzędy 1, 3, 5, 7 (kolumny 0, 2, 4, 6)
+const uint32_t LEFT_EDGE = 0x10101010u;  // kolumna 0
+const uint32_t RIGHT_EDGE = 0x08080808u; // kolumna 7
+
+// przesunięcie wszystkich bitów o jedno pole w kierunku Dir (to, co wypada za planszę, znika)
+template <int Dir>
+constexpr uint32_t shiftDirection(uint32_t bb) {
+    if constexpr (Dir == 0) return ((bb & EVEN_ROWS) >> 4) | ((bb & ODD_ROWS & ~LEFT_EDGE) >> 5);
+    else if constexpr (Dir == 1) return ((bb & EVEN_ROWS & ~RIGHT_EDGE) >> 3) | ((bb & ODD_ROWS) >> 4);
+    else if constexpr (Dir == 2) return ((bb & EVEN_ROWS) << 4) | ((bb & ODD_ROWS & ~LEFT_EDGE) << 3);
+    else return ((bb & EVEN_ROWS & ~RIGHT_EDGE) << 5) | ((bb & ODD_ROWS) << 4);
+}
+
+inline uint32_t shiftDirection(uint32_t bb, int dir) {
+    switch (dir) {
+        case 0: return shiftDirection<0>(bb);
+        case 1: return shiftDirection<1>(bb);
+        case 2: return shiftDirection<2>(bb);
+        default: return shiftDirection<3>(bb);
+    }
+}
+
+// tablice sąsiadów i promieni (dla damek), liczone w czasie kompilacji
+struct BitboardTables {
+    int neighbor[32][4];  // pole obok w danym kierunku, -1 poza planszą
+    uint32_t ray[32][4];  // wszystkie pola po przekątnej w danym kierunku (bez pola startowego)
+};
+
+constexpr BitboardTables makeBitboardTables() {
+    BitboardTables t{};
+    for (int sq = 0; sq < 32; ++sq) {
+        int row = sq / 4;
+        int col = (sq % 4) * 2 + (row + 1) % 2;
+        for (int d = 0; d < 4; ++d) {
+            t.neighbor[sq][d] = -1;
+            t.ray[sq][d] = 0;
+            int r = row + DIR_ROW[d];
+            int c = col + DIR_COL[d];
+            while (r >= 0 && r < 8 && c >= 0 && c < 8) {
+                if (t.neighbor[sq][d] < 0) t.neighbor[sq][d] = r * 4 + c / 2;
+                t.ray[sq][d] |= 1u << (r * 4 + c / 2);
+                r += DIR_ROW[d];
+                c += DIR_COL[d];
+            }
+        }
+    }
+    return t;
+}
+
+inline constexpr BitboardTables BB_TABLES = makeBitboardTables();
+
+// pierwsze zajęte pole na promieniu (blockers != 0); kierunki "w dół" rosną w numeracji pól
+inline int firstBlocker(uint32_t blockers, int dir) {
+    return (dir >= 2) ? __builtin_ctz(blockers) : 31 - __builtin_clz(blockers);
+}
+
+// klucze Zobrista: pole x (kolor * 2 + damka) oraz strona na ruchu (czarne)
+struct ZobristKeys {
+    uint64_t piece[32][4];
+    uint64_t blackToMove;
+};
+
+constexpr uint64_t splitMix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+constexpr ZobristKeys makeZobristKeys() {
+    ZobristKeys keys{};
+    uint64_t state = 0x2545F4914F6CDD1Dull;
+    for (int sq = 0; sq < 32; ++sq) {
+        for (int kind = 0; kind < 4; ++kind) {
+            keys.piece[sq][kind] = splitMix64(state);
+        }
+    }
+    keys.blackToMove = splitMix64(state);
+    return keys;
+}
+
+inline constexpr ZobristKeys ZOBRIST = makeZobristKeys();
+
+inline uint64_t zobristPiece(int sq, Piececolor color, bool isKing) {
+    return ZOBRIST.piece[sq][static_cast<int>(color) * 2 + (isKing ? 1 : 0)];
+}
+
+// to, czego nie da się odtworzyć z samego ruchu - wystarcza do cofnięcia applyMove
+struct UndoInfo {
+    uint32_t captured = 0;      // zbite pionki przeciwnika
+    uint32_t capturedKings = 0; // które z nich były damkami
+    bool promoted = false;      // czy ruch zrobił damkę
+    Piececolor previousPlayer = Piececolor::White;
+    uint64_t previousHash = 0;
+    int previousStaticScore = 0;
+};
+
+class Bitboard {
+private:
+    uint32_t white = 0;
+    uint32_t black = 0;
+    uint32_t kings = 0;
+    Piececolor currentPlayer = Piececolor::White;
+    uint64_t hash = 0;       // klucz Zobrista aktualizowany przy każdej zmianie
+    int staticScore = 0;     // suma PIECE_SQUARE_SCORES aktualizowana razem z kluczem
+
+    // w trybie debug porównuje klucz i sumę przyrostową z policzonymi od zera
+    void checkIncremental() const {
+        assert(hash == computeHash());
+        assert(staticScore == computeStaticScore());
+    }
+
+    template <Piececolor Color>
+    uint32_t& piecesOf() {
+        if constexpr (Color == Piececolor::White) return white;
+        else return black;
+    }
+
+    // pionek pojawia się na polu / znika z pola - klucz i suma zmieniają się tak samo (XOR / +-)
+    void togglePiece(int sq, Piececolor color, bool isKing, int sign) {
+        hash ^= zobristPiece(sq, color, isKing);
+        staticScore += sign * pieceSquareScore(sq, color, isKing);
+    }
+
+public:
+    void initialize();
+    void clear();
+    void setPosition(uint32_t whitePieces, uint32_t blackPieces, uint32_t kingPieces, Piececolor toMove);
+
+    uint32_t getPieces(Piececolor color) const { return (color == Piececolor::White) ? white : black; }
+    template <Piececolor Color>
+    uint32_t getPieces() const {
+        if constexpr (Color == Piececolor::White) return white;
+        else return black;
+    }
+    uint32_t getKings() const { return kings; }
+    uint32_t getOccupied() const { return white | black; }
+    uint32_t getEmpty() const { return ~(white | black); }
+
+    bool hasPiece(int sq) const { return getOccupied() & squareBit(sq); }
+    std::optional<Piece> getPiece(int sq) const;
+    void setPiece(int sq, const Piece& piece);
+    void removePiece(int sq);
+    void makeKing(int sq);
+
+    MoveList getAllValidMoves(Piececolor playerColor) const;
+    void addCaptureMoves(Piececolor playerColor, MoveList& moves) const;
+    void addQuietMoves(Piececolor playerColor, MoveList& moves) const;
+    int countCaptureMoves(Piececolor playerColor) const;
+    int countQuietMoves(Piececolor playerColor) const;
+    int countMoves(Piececolor playerColor) const;  // == getAllValidMoves(playerColor).size()
+    bool hasAnyMove(Piececolor playerColor) const;
+    UndoInfo applyMove(const Move& move);
+    void undoMove(const Move& move, const UndoInfo& undo);
+
+    // to samo dla koloru znanego w czasie kompilacji (definicje w Bitboard.cpp, dla obu kolorów)
+    template <Piececolor Color> MoveList getAllValidMoves() const;
+    template <Piececolor Color> void addCaptureMoves(MoveList& moves) const;
+    template <Piececolor Color> void addQuietMoves(MoveList& moves) const;
+    template <Piececolor Color> int countCaptureMoves() const;
+    template <Piececolor Color> int countQuietMoves() const;
+    template <Piececolor Color> int countMoves() const;
+    template <Piececolor Color> bool hasAnyMove() const;
+    // ruch pionka koloru Color (ten kolor musi być na ruchu)
+    template <Piececolor Color> UndoInfo applyMove(const Move& move);
+    template <Piececolor Color> void undoMove(const Move& move, const UndoInfo& undo);
+
+    Piececolor getCurrentPlayer() const { return currentPlayer; }
+    void setCurrentPlayer(Piececolor color);
+
+    uint64_t getHash() const { return hash; }
+    uint64_t computeHash() const;
+
+    int getStaticScore() const { return staticScore; }
+    int computeStaticScore() const;
+};
+
+#endif
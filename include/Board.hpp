@@ -3,22 +3,26 @@
 
 #include "Tile.hpp"
 #include "Move.hpp"
+#include "Bitboard.hpp"
 
 /*
-Board - plansza
-co wie: 64 pola (2D tablica Tile)
+Board - plansza (adapter dla viz.cpp)
+co wie: pozycję jako Bitboard; 64 pola (2D tablica Tile) jako kopię do rysowania
 co umie:
     * inicjalizuje lokalizacje początkowę
     * zwraca komórkę według współrzędnych
-    * zastosować ruch
-    * zwraca wszystkie możliwe ruchy dla gracza
+    * zastosować ruch / cofnąć ruch
+    * zwraca wszystkie możliwe ruchy dla gracza; liczy je i sprawdza, czy jakiś jest (bez listy ruchów)
     * sprawdza czy ruch jest wykonalny
 */
 class Board {
 private:
     static const int SIZE = 8;
-    Tile tiles[SIZE][SIZE];
-    Piececolor currentPlayer = Piececolor::White; // Начинаем с белых
+    Tile tiles[SIZE][SIZE]; // tylko do odczytu, synchronizowane z position
+    Bitboard position;
+
+    void syncTile(int row, int col);
+    void syncMoveTiles(const Move& move);
 
 public:
     Board();
@@ -28,14 +32,16 @@ public:
     const Tile& getTile(int row, int col) const;
     bool isValidMove(const Move& move, Piececolor playerColor) const;
     std::vector<Move> getAllValidMoves(Piececolor playerColor) const;
-    void applyMove(const Move& move);
-    void findMultiCaptures(Position from,
-                               std::vector<Position> captured,
-                               std::vector<Move>& result,
-                               Piececolor color,
-                               Piecetype type,
-                               const Move& currentMove) const;
-    Piececolor getCurrentPlayer() const { return currentPlayer; }
+    int countMoves(Piececolor playerColor) const { return position.countMoves(playerColor); }
+    bool hasAnyMove(Piececolor playerColor) const { return position.hasAnyMove(playerColor); }
+    UndoInfo applyMove(const Move& move);
+    void undoMove(const Move& move, const UndoInfo& undo);
+    void setPiece(int row, int col, const Piece& piece);
+    void removePiece(int row, int col);
+    void makeKing(int row, int col);
+    const Bitboard& getBitboard() const { return position; }
+    uint64_t getHash() const { return position.getHash(); }
+    Piececolor getCurrentPlayer() const { return position.getCurrentPlayer(); }
     //bool isInsideBoard(int row, int col) const;
     //std::vector<Move> getAllPossibleMoves(Piececolor playerColor) const;
 };
@@ -1,6 +1,10 @@
 #ifndef MOVE_H
 #define MOVE_H
 
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
 #include <vector>
 
 // Position - zawiera współrzędne (row, col)
@@ -19,25 +23,123 @@ struct Position
     }
 };
 
+// Numeracja ciemnych pól: sq = row * 4 + col / 2, bit (1u << sq)
+inline int squareIndex(int row, int col) {
+    return row * 4 + col / 2;
+}
+
+inline Position squarePosition(int sq) {
+    int row = sq / 4;
+    return {row, (sq % 4) * 2 + (row + 1) % 2};
+}
+
+inline uint32_t squareBit(int sq) {
+    return 1u << sq;
+}
+
+inline int popCount(uint32_t bb) {
+    return __builtin_popcount(bb);
+}
+
+// indeks najniższego ustawionego bitu (bb != 0)
+inline int lowestSquare(uint32_t bb) {
+    return __builtin_ctz(bb);
+}
+
+/*
+CapturedList - zbite pola zapisane jako maska bitowa; da się po niej iterować jak po liście Position
+*/
+class CapturedList
+{
+private:
+    uint32_t mask;
+
+public:
+    class iterator {
+    private:
+        uint32_t rest;
+    public:
+        explicit iterator(uint32_t rest) : rest(rest) {}
+        Position operator*() const { return squarePosition(lowestSquare(rest)); }
+        iterator& operator++() { rest &= rest - 1; return *this; }
+        bool operator!=(const iterator& other) const { return rest != other.rest; }
+    };
+
+    explicit CapturedList(uint32_t mask) : mask(mask) {}
+    iterator begin() const { return iterator(mask); }
+    iterator end() const { return iterator(0); }
+    bool empty() const { return mask == 0; }
+    size_t size() const { return popCount(mask); }
+};
+
 /* 
 odpowiada za jeden ruch
-co wie: skąd i dokąd; które pionki zostały zbite 
+co wie: skąd i dokąd; które pionki zostały zbite (maska pól, bez alokacji - Move da się kopiować jak int)
 co umie: zwraca czy było bicie 
+Metody są inline, bo ruchy powstają i są kopiowane w każdym węźle wyszukiwania.
 */
 class Move
 {
 private:
-    Position from;
-    Position to;
-    std::vector<Position> captured; // współrzędne zbitych pionków
+    int8_t fromRow, fromCol;
+    int8_t toRow, toCol;
+    uint32_t captured; // maska zbitych pól (numeracja squareIndex)
 
 public:
-    Move(Position from, Position to);
-    Position getFrom() const;
-    Position getTo() const;
-    const std::vector<Position>& getCaptured() const;
-    void addCaptured(Position pos); // dla > 1 bicie
-    bool isCapture() const;
+    Move() = default;
+    Move(Position from, Position to)
+        : fromRow(static_cast<int8_t>(from.row)), fromCol(static_cast<int8_t>(from.col)),
+          toRow(static_cast<int8_t>(to.row)), toCol(static_cast<int8_t>(to.col)), captured(0) {}
+
+    Position getFrom() const { return {fromRow, fromCol}; }
+    Position getTo() const { return {toRow, toCol}; }
+    int getFromSquare() const { return squareIndex(fromRow, fromCol); }
+    int getToSquare() const { return squareIndex(toRow, toCol); }
+
+    CapturedList getCaptured() const { return CapturedList(captured); }
+    uint32_t getCapturedMask() const { return captured; }
+    void addCaptured(Position pos) { // dla > 1 bicie
+        assert(pos.isValid() && (pos.row + pos.col) % 2 == 1);
+        captured |= squareBit(squareIndex(pos.row, pos.col));
+    }
+    bool isCapture() const { return captured != 0; }
+};
+
+static_assert(std::is_trivially_copyable<Move>::value, "Move musi dać się kopiować bez alokacji");
+
+/*
+MoveList - lista ruchów w buforze o stałym rozmiarze (na stosie, bez alokacji)
+MAX_MOVES: ruch to para (skąd, dokąd) - najwięcej 12 damek po 13 pól na przekątnych = 156
+*/
+class MoveList
+{
+public:
+    static const int MAX_MOVES = 160;
+
+private:
+    Move moves[MAX_MOVES];
+    int count = 0;
+
+public:
+    void push_back(const Move& move) {
+        assert(count < MAX_MOVES);
+        moves[count++] = move;
+    }
+    void emplace_back(Position from, Position to) { push_back(Move(from, to)); }
+    void clear() { count = 0; }
+
+    int size() const { return count; }
+    bool empty() const { return count == 0; }
+    Move& operator[](int i) { return moves[i]; }
+    const Move& operator[](int i) const { return moves[i]; }
+    Move& front() { return moves[0]; }
+    const Move& front() const { return moves[0]; }
+    Move* begin() { return moves; }
+    Move* end() { return moves + count; }
+    const Move* begin() const { return moves; }
+    const Move* end() const { return moves + count; }
+
+    std::vector<Move> toVector() const { return std::vector<Move>(begin(), end()); }
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,156 @@
+#ifndef MOVEORDERING_H
+#define MOVEORDERING_H
+
+#include "Bitboard.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+// maksymalna liczba ply w jednej gałęzi przeszukiwania
+const int MAX_PLY = 128;
+const int NO_MOVE = -1;
+
+// ruch jako (skąd * 32 + dokąd) wg numeracji Bitboard - wystarcza, żeby rozpoznać ruch na liście
+inline int moveKey(const Move& move) {
+    return move.getFromSquare() * 32 + move.getToSquare();
+}
+
+inline int moveKey(int fromSq, int toSq) {
+    return fromSq * 32 + toSq;
+}
+
+/*
+OrderingTables - heurystyki kolejności ruchów dla jednego przeszukiwania
+co wie: dwa ruchy killer na każdy ply; tablicę historii [kolor][skąd][dokąd]
+co umie: zapamiętuje cichy ruch, który dał cięcie beta
+*/
+struct OrderingTables {
+    static const int HISTORY_LIMIT = 1 << 20;
+
+    int killers[MAX_PLY][2];
+    int history[2][32][32];
+
+    void clear() {
+        for (auto& slots : killers) slots[0] = slots[1] = NO_MOVE;
+        for (auto& side : history)
+            for (auto& from : side)
+                for (int& value : from) value = 0;
+    }
+
+    void recordCutoff(const Move& move, Piececolor color, int depth, int ply) {
+        if (move.isCapture()) return;
+
+        int key = moveKey(move);
+        if (ply < MAX_PLY && killers[ply][0] != key) {
+            killers[ply][1] = killers[ply][0];
+            killers[ply][0] = key;
+        }
+
+        int& value = history[static_cast<int>(color)][key / 32][key % 32];
+        value += depth * depth;
+        // starzenie: po przekroczeniu limitu wszystkie wartości danego koloru maleją o połowę
+        if (value >= HISTORY_LIMIT) {
+            for (auto& from : history[static_cast<int>(color)])
+                for (int& v : from) v /= 2;
+        }
+    }
+};
+
+// etapy wybierania ruchów
+enum class PickStage : uint8_t { HashMove, Capture, Killer, Quiet };
+const int PICK_STAGE_COUNT = 4;
+
+// nazwa etapu w raportach (viz, Measure)
+inline const char* pickStageName(PickStage stage) {
+    static const char* const NAMES[PICK_STAGE_COUNT] = {"hash", "capture", "killer", "quiet"};
+    return NAMES[static_cast<int>(stage)];
+}
+
+// statystyki cięć beta - jak dobrze działa kolejność ruchów
+struct OrderingStats {
+    static const int MOVE_INDEX_SLOTS = 8;  // ostatni licznik zbiera cięcia na ruchach o indeksie 7 i dalszych
+
+    uint64_t betaCutoffs = 0;
+    uint64_t firstMoveCutoffs = 0;
+    uint64_t cutoffsByStage[PICK_STAGE_COUNT] = {};  // etap MovePicker, z którego przyszedł ruch tnący
+    uint64_t cutoffsByMoveIndex[MOVE_INDEX_SLOTS] = {};
+
+    void recordCutoff(int moveIndex, PickStage stage) {
+        betaCutoffs++;
+        if (moveIndex == 0) firstMoveCutoffs++;
+        cutoffsByStage[static_cast<int>(stage)]++;
+        cutoffsByMoveIndex[std::min(moveIndex, MOVE_INDEX_SLOTS - 1)]++;
+    }
+
+    void merge(const OrderingStats& other) {
+        betaCutoffs += other.betaCutoffs;
+        firstMoveCutoffs += other.firstMoveCutoffs;
+        for (int i = 0; i < PICK_STAGE_COUNT; ++i) cutoffsByStage[i] += other.cutoffsByStage[i];
+        for (int i = 0; i < MOVE_INDEX_SLOTS; ++i) cutoffsByMoveIndex[i] += other.cutoffsByMoveIndex[i];
+    }
+
+    double firstMoveCutoffRate() const {
+        return betaCutoffs ? static_cast<double>(firstMoveCutoffs) / betaCutoffs : 0.0;
+    }
+};
+
+/*
+MovePicker - zwraca ruchy po kolei: ruch z tabeli transpozycji, bicia (najpierw te z większą
+liczbą zbitych), dwa killery z tego ply, potem ciche ruchy wg historii.
+Sortowanie jest leniwe (wybór największego) - po szybkim cięciu reszta listy nie jest ruszana.
+*/
+class MovePicker {
+private:
+    static const int HASH_SCORE = 1 << 30;
+    static const int CAPTURE_SCORE = 1 << 28;
+    static const int KILLER_SCORE = 1 << 26;
+
+    MoveList& moves;
+    int scores[MoveList::MAX_MOVES];
+    int current = 0;
+    PickStage lastStage = PickStage::Quiet;
+
+public:
+    MovePicker(MoveList& moves, int hashMove, const OrderingTables& tables, Piececolor color, int ply)
+        : moves(moves) {
+        const int* killers = (ply < MAX_PLY) ? tables.killers[ply] : nullptr;
+        for (int i = 0; i < moves.size(); ++i) {
+            int key = moveKey(moves[i]);
+            if (key == hashMove) {
+                scores[i] = HASH_SCORE;
+            } else if (moves[i].isCapture()) {
+                scores[i] = CAPTURE_SCORE + static_cast<int>(moves[i].getCaptured().size());
+            } else if (killers && key == killers[0]) {
+                scores[i] = KILLER_SCORE + 1;
+            } else if (killers && key == killers[1]) {
+                scores[i] = KILLER_SCORE;
+            } else {
+                scores[i] = tables.history[static_cast<int>(color)][key / 32][key % 32];
+            }
+        }
+    }
+
+    // następny ruch albo nullptr, gdy lista się skończyła
+    const Move* next() {
+        if (current >= moves.size()) return nullptr;
+        int best = current;
+        for (int i = current + 1; i < moves.size(); ++i) {
+            if (scores[i] > scores[best]) best = i;
+        }
+        if (best != current) {
+            std::swap(moves[best], moves[current]);
+            std::swap(scores[best], scores[current]);
+        }
+
+        int score = scores[current];
+        lastStage = (score >= HASH_SCORE) ? PickStage::HashMove
+                  : (score >= CAPTURE_SCORE) ? PickStage::Capture
+                  : (score >= KILLER_SCORE) ? PickStage::Killer
+                  : PickStage::Quiet;
+        return &moves[current++];
+    }
+
+    PickStage getStage() const { return lastStage; }
+};
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef NOTATION_H
+#define NOTATION_H
+
+#include "Bitboard.hpp"
+#include <string>
+
+/*
+Zapis pozycji tekstem w stylu FEN z PDN: "<na ruchu>:W<pola białych>:B<pola czarnych>"
+    * pola numerowane 1-32 (squareIndex + 1): 1-4 to rząd 0 (strona czarnych), 29-32 to rząd 7
+    * K przed numerem - damka, "a-b" - wszystkie pola od a do b
+np. pozycja początkowa: "W:W21-32:B1-12"
+*/
+bool parsePosition(const std::string& text, Bitboard& board);
+std::string formatPosition(const Bitboard& board);
+
+// ruch jako "9-13", bicie jako "9x18"
+std::string formatMove(const Move& move);
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef OPENINGBOOK_H
+#define OPENINGBOOK_H
+
+#include "Bitboard.hpp"
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+/*
+Wpis książki debiutowej: pozycja (klucz Zobrista, czarne na ruchu), ruch (pola skąd / dokąd) i waga.
+Ruch jest zapisany polami, bo przy pojedynczym biciu para (skąd, dokąd) wyznacza go jednoznacznie.
+Plik: nagłówek {"CKOB", wersja, liczba wpisów} i wpisy posortowane po kluczu.
+*/
+struct OpeningBookEntry {
+    uint64_t key;
+    uint8_t fromSquare;
+    uint8_t toSquare;
+    uint16_t weight;
+    uint32_t reserved;
+};
+
+bool writeOpeningBook(const std::string& path, std::vector<OpeningBookEntry> entries);
+
+/*
+OpeningBook - książka debiutowa wczytywana z pliku OpeningBookGen
+co wie: wpisy posortowane po kluczu, generator losowy do wyboru ruchu
+co umie: dla pozycji z książki zwraca jeden z zapisanych ruchów (losowo, proporcjonalnie do wag)
+*/
+class OpeningBook {
+private:
+    std::vector<OpeningBookEntry> entries;
+    std::mutex randomMutex;
+    std::mt19937 random{std::random_device{}()};
+
+public:
+    // false, gdy pliku nie ma albo jest uszkodzony (książka zostaje wtedy pusta)
+    bool open(const std::string& path);
+    size_t size() const { return entries.size(); }
+
+    // ruch z książki dla pozycji z czarnymi na ruchu; false, gdy pozycji nie ma w książce
+    bool probe(const Bitboard& board, Move& move);
+};
+
+// książka używana przez AI (pusta, dopóki nikt nie wywoła open)
+OpeningBook& openingBook();
+
+#endif
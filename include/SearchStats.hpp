@@ -0,0 +1,57 @@
+#ifndef SEARCHSTATS_H
+#define SEARCHSTATS_H
+
+#include "MoveOrdering.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// raport po każdej ukończonej iteracji pogłębiania
+struct SearchIteration {
+    int depth = 0;
+    int score = 0;           // z perspektywy czarnych
+    Move bestMove;
+    uint64_t nodes = 0;      // węzły wszystkich wątków od startu (z dokładnością do 1024 na wątek)
+    double elapsedMs = 0;    // od startu przeszukiwania
+};
+
+/*
+SearchStats - liczniki jednego przeszukiwania
+Każdy wątek liczy we własnym SearchContext (zwykłe pola, bez atomowych operacji i blokad),
+a findBestMove sumuje je po zakończeniu (merge).
+*/
+struct SearchStats {
+    uint64_t nodes = 0;             // węzły minimax i quiescence
+    uint64_t quiescenceNodes = 0;
+    uint64_t evaluations = 0;       // oceny statyczne (liście)
+    uint64_t moveGenerations = 0;   // wywołania generatora ruchów
+    uint64_t ttProbes = 0;
+    uint64_t ttHits = 0;
+    uint64_t ttCutoffs = 0;         // węzły zakończone od razu wynikiem z tabeli transpozycji
+    uint64_t tablebaseHits = 0;
+    int maxSelectiveDepth = 0;      // najgłębszy ply razem z wyszukiwaniem spoczynkowym
+    OrderingStats ordering;         // cięcia beta (wg etapu i indeksu ruchu)
+
+    int threads = 1;
+    double timeMs = 0;
+    std::vector<SearchIteration> iterations;  // tylko wątek główny
+
+    void merge(const SearchStats& other) {
+        nodes += other.nodes;
+        quiescenceNodes += other.quiescenceNodes;
+        evaluations += other.evaluations;
+        moveGenerations += other.moveGenerations;
+        ttProbes += other.ttProbes;
+        ttHits += other.ttHits;
+        ttCutoffs += other.ttCutoffs;
+        tablebaseHits += other.tablebaseHits;
+        maxSelectiveDepth = std::max(maxSelectiveDepth, other.maxSelectiveDepth);
+        ordering.merge(other.ordering);
+    }
+
+    int depth() const { return iterations.empty() ? 0 : iterations.back().depth; }
+    double ttHitRate() const { return ttProbes ? static_cast<double>(ttHits) / ttProbes : 0.0; }
+    double nodesPerSecond() const { return timeMs > 0 ? nodes / timeMs * 1000.0 : 0.0; }
+};
+
+#endif
@@ -0,0 +1,185 @@
+#ifndef TABLEBASE_H
+#define TABLEBASE_H
+
+#include "Bitboard.hpp"
+#include "MappedFile.hpp"
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// największa liczba pionków w bazie końcówek
+const int TB_MAX_PIECES = 6;
+
+/*
+Pozycje w bazie są zawsze widziane od strony gracza na ruchu ("nasze"): gdy na ruchu są białe,
+plansza jest obracana o 180 stopni (pole sq -> 31 - sq) i kolory się zamieniają. Dzięki temu
+nasze pionki zawsze idą w stronę rzędu 7, a baza nie musi pamiętać, kto jest na ruchu.
+*/
+
+// skład materiału od strony gracza na ruchu
+struct MaterialSignature {
+    int ourMen = 0;
+    int ourKings = 0;
+    int theirMen = 0;
+    int theirKings = 0;
+
+    int total() const { return ourMen + ourKings + theirMen + theirKings; }
+    int key() const { return ((ourMen * 7 + ourKings) * 7 + theirMen) * 7 + theirKings; }
+    // ten sam materiał widziany od strony przeciwnika
+    MaterialSignature swapped() const { return {theirMen, theirKings, ourMen, ourKings}; }
+    bool operator==(const MaterialSignature& other) const { return key() == other.key(); }
+};
+
+const int TB_SIGNATURE_COUNT = 7 * 7 * 7 * 7;
+
+// pozycja od strony gracza na ruchu (maski po ewentualnym obrocie)
+struct TablebasePosition {
+    uint32_t ourMen = 0;
+    uint32_t ourKings = 0;
+    uint32_t theirMen = 0;
+    uint32_t theirKings = 0;
+
+    MaterialSignature signature() const;
+    // jako Bitboard z czarnymi (naszymi) na ruchu
+    Bitboard toBitboard() const;
+};
+
+/*
+Wpis bazy (1 bajt):
+    0   - remis (żadna strona nie wymusi wygranej)
+    1.. - liczba ply do końca gry + 1; nieparzysta liczba ply = wygrana gracza na ruchu, parzysta = przegrana
+    255 - pozycja niemożliwa (dwa pionki na jednym polu)
+*/
+const uint8_t TB_DRAW = 0;
+const uint8_t TB_INVALID = 255;
+const int TB_MAX_DISTANCE = 253;
+
+inline uint8_t tbEncodeDistance(int plies) { return static_cast<uint8_t>(plies + 1); }
+inline int tbDistance(uint8_t value) { return value - 1; }
+inline bool tbIsWin(uint8_t value) { return value != TB_DRAW && value != TB_INVALID && tbDistance(value) % 2 == 1; }
+inline bool tbIsLoss(uint8_t value) { return value != TB_DRAW && value != TB_INVALID && tbDistance(value) % 2 == 0; }
+
+/*
+Indeksowanie - system kombinatoryczny (colex) dla każdej grupy pionków osobno:
+nasze pionki na polach 0-27 (w rzędzie 7 byłyby już damkami), ich pionki na polach 4-31, damki na wszystkich 32.
+indeks = ((naszePionki * C(28, ichPionki) + ichPionki) * C(32, naszeDamki) + naszeDamki) * C(32, ichDamki) + ichDamki
+Zestawy nachodzące na siebie dostają wpis TB_INVALID - prościej niż gęste indeksowanie, a baza i tak jest mała.
+*/
+uint64_t tablebaseSize(const MaterialSignature& signature);
+uint64_t tablebaseIndex(const TablebasePosition& position);
+bool tablebasePosition(const MaterialSignature& signature, uint64_t index, TablebasePosition& position);
+TablebasePosition normalizePosition(const Bitboard& board, Piececolor toMove);
+
+/*
+Plik z bazą jednego składu materiału:
+    nagłówek | przesunięcia bloków (blockCount + 1 liczb uint64) | bloki
+Każdy blok to TB_BLOCK_SIZE kolejnych wpisów skompresowanych osobno (PackBits - wpisy to głównie długie
+serie remisów i pozycji niemożliwych), więc do sondy wystarczy rozpakować jeden blok.
+*/
+const uint32_t TB_BLOCK_SIZE = 1 << 16;
+
+std::string tablebaseFileName(const std::string& directory, const MaterialSignature& signature);
+bool writeTablebaseFile(const std::string& path, const MaterialSignature& signature, const std::vector<uint8_t>& values);
+// cały plik rozpakowany do pamięci (generator przy wznawianiu)
+bool readTablebaseFile(const std::string& path, const MaterialSignature& signature, std::vector<uint8_t>& values);
+
+// baza jednego składu: cała w pamięci (generator) albo zmapowany plik z blokami
+struct TablebaseSlice {
+    int key = 0;                    // MaterialSignature::key
+    uint64_t entries = 0;
+    std::vector<uint8_t> values;    // niepuste - cała baza w pamięci
+    MappedFile file;
+    const uint8_t* offsets = nullptr;  // blockCount + 1 przesunięć (uint64, bez wyrównania)
+    const uint8_t* blocks = nullptr;
+    uint32_t blockCount = 0;
+
+    bool openFile(const std::string& path, const MaterialSignature& signature);
+    // rozpakowuje blok (out ma TB_BLOCK_SIZE bajtów albo mniej dla ostatniego bloku)
+    bool readBlock(uint32_t block, std::vector<uint8_t>& out) const;
+};
+
+// domyślny rozmiar pamięci podręcznej rozpakowanych bloków (MB)
+const size_t TB_DEFAULT_CACHE_MB = 16;
+
+/*
+TablebaseBlockCache - ostatnio używane rozpakowane bloki baz (LRU)
+co wie: bloki podzielone na kilka części z osobnymi blokadami, żeby wątki przeszukiwania sobie nie przeszkadzały
+co umie: zwraca wpis z bloku, rozpakowując go przy chybieniu i wyrzucając najdawniej używany
+*/
+class TablebaseBlockCache {
+private:
+    static const int SHARDS = 8;
+
+    struct Shard {
+        std::mutex mutex;
+        std::list<std::pair<uint64_t, std::vector<uint8_t>>> blocks;  // od najświeższego
+        std::unordered_map<uint64_t, std::list<std::pair<uint64_t, std::vector<uint8_t>>>::iterator> index;
+    };
+
+    Shard shards[SHARDS];
+    size_t blocksPerShard = 1;
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+
+public:
+    TablebaseBlockCache() { setCapacity(TB_DEFAULT_CACHE_MB); }
+    void setCapacity(size_t megabytes);
+    void clear();
+    uint8_t value(const TablebaseSlice& slice, uint32_t block, uint32_t offset);
+
+    uint64_t getHits() const { return hits; }
+    uint64_t getMisses() const { return misses; }
+};
+
+// wynik sondy z perspektywy gracza na ruchu
+enum class TbResult : uint8_t { Draw, Win, Loss };
+
+struct TbProbe {
+    TbResult result = TbResult::Draw;
+    int distance = 0; // ply do końca gry przy najlepszej grze obu stron
+};
+
+/*
+EndgameTablebase - bazy końcówek mapowane z katalogu przy pierwszym użyciu danego składu materiału
+co wie: katalog z plikami, limit pionków, otwarte bazy, pamięć podręczną rozpakowanych bloków
+co umie:
+    * zwraca surowy wpis dla składu i indeksu (generator)
+    * sonduje pozycję (minimax) - start jest natychmiastowy, a w pamięci są tylko ostatnio używane bloki
+*/
+class EndgameTablebase {
+private:
+    std::string directory;
+    std::atomic<int> maxPieces{0};
+
+    std::mutex loadMutex;
+    std::vector<std::unique_ptr<TablebaseSlice>> storage;
+    std::atomic<const TablebaseSlice*> slices[TB_SIGNATURE_COUNT] = {};
+    std::atomic<bool> missing[TB_SIGNATURE_COUNT] = {};
+    TablebaseBlockCache cache;
+
+    const TablebaseSlice* slice(const MaterialSignature& signature);
+
+public:
+    // katalog z plikami tb_*.bin; bazy do maxPieces pionków (0 - wyłączone)
+    void open(const std::string& directory, int maxPieces);
+    int getMaxPieces() const { return maxPieces.load(std::memory_order_relaxed); }
+
+    // wpis dla pozycji; TB_INVALID, gdy brak pliku z tym składem
+    uint8_t lookup(const TablebasePosition& position);
+    bool probe(const Bitboard& board, Piececolor toMove, TbProbe& result);
+
+    // dołącza gotową tablicę bez czytania pliku (generator po zapisaniu składu)
+    void install(const MaterialSignature& signature, std::vector<uint8_t> values);
+
+    TablebaseBlockCache& getCache() { return cache; }
+};
+
+// baza używana przez AI (pusta, dopóki nikt nie wywoła open)
+EndgameTablebase& endgameTablebase();
+
+#endif
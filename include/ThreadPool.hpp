@@ -0,0 +1,56 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ThreadPool - stała pula wątków z kradzieżą zadań (work stealing)
+co wie: kolejkę zadań każdego wątku; ile zadań czeka i ile jeszcze się nie skończyło
+co umie:
+    * przyjmuje zadanie (rozdzielane po kolei między kolejki wątków)
+    * wątek bierze zadania z końca własnej kolejki, a gdy jest pusta - kradnie z początku cudzej
+    * czeka, aż wszystkie przyjęte zadania się skończą
+Zadanie dostaje numer wątku, który je wykonuje (0..size()-1) - do wybrania stanu tego wątku.
+*/
+class ThreadPool {
+public:
+    using Task = std::function<void(int workerIndex)>;
+
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread> threads;
+
+    std::mutex stateMutex;
+    std::condition_variable workAvailable;
+    std::condition_variable allDone;
+    size_t queuedTasks = 0;   // w kolejkach
+    size_t pendingTasks = 0;  // przyjęte, a jeszcze nieskończone
+    size_t nextQueue = 0;
+    bool stopping = false;
+
+    bool popTask(int workerIndex, Task& task);
+    void workerLoop(int workerIndex);
+
+public:
+    explicit ThreadPool(int threadCount);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(Task task);
+    void wait();
+    int size() const { return static_cast<int>(threads.size()); }
+};
+
+#endif
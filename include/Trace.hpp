@@ -0,0 +1,57 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/*
+Śledzenie przebiegu przeszukiwania w czasie (format Chrome trace - chrome://tracing, ui.perfetto.dev).
+Domyślnie wyłączone: każde miejsce pomiaru sprawdza wtedy tylko jedną flagę.
+Po włączeniu każdy wątek zapisuje zdarzenia do własnego bufora cyklicznego (bez blokad - pisze tylko on,
+najstarsze zdarzenia są nadpisywane), a writeTrace zapisuje wszystkie bufory jako JSON.
+writeTrace i clearTrace woła się, gdy nic nie jest liczone (np. po findBestMove).
+Nazwy zdarzeń, kategorii i argumentów muszą być stałymi napisami - bufor trzyma tylko wskaźniki.
+*/
+
+extern std::atomic<bool> traceActive;
+
+inline bool traceEnabled() { return traceActive.load(std::memory_order_relaxed); }
+void enableTrace(bool enabled);
+void clearTrace();
+bool writeTrace(const std::string& path);
+
+// nazwa ścieżki bieżącego wątku na osi czasu
+void setTraceThreadName(const char* name);
+
+uint64_t traceNow(); // ns od włączenia śledzenia
+void traceComplete(const char* name, const char* category, uint64_t start, const char* argName = nullptr, int64_t arg = 0);
+void traceCounter(const char* name, int64_t value);
+void traceInstant(const char* name, const char* category);
+
+/*
+TraceScope - zdarzenie trwające od utworzenia do końca zakresu
+Zapisywane tylko wtedy, gdy śledzenie było włączone przy utworzeniu (i warunek when był spełniony).
+*/
+class TraceScope {
+private:
+    const char* name;
+    const char* category;
+    const char* argName;
+    int64_t arg;
+    uint64_t start;
+    bool active;
+
+public:
+    TraceScope(const char* name, const char* category, const char* argName = nullptr, int64_t arg = 0, bool when = true)
+        : name(name), category(category), argName(argName), arg(arg), start(0), active(when && traceEnabled()) {
+        if (active) start = traceNow();
+    }
+    ~TraceScope() {
+        if (active) traceComplete(name, category, start, argName, arg);
+    }
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+};
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef TRANSPOSITIONTABLE_H
+#define TRANSPOSITIONTABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// rodzaj wyniku zapisanego w tabeli
+enum class Bound : uint8_t { None, Exact, Lower, Upper };
+
+/*
+TTEntry - jeden wpis tabeli transpozycji (rozpakowany, patrz TTSlot)
+co wie: klucz Zobrista, głębokość, wynik, rodzaj wyniku, najlepszy ruch (pola wg numeracji Bitboard)
+*/
+struct TTEntry {
+    uint64_t key = 0;
+    int32_t score = 0;
+    int8_t depth = -1; // -1 = pusty wpis
+    Bound bound = Bound::None;
+    uint8_t moveFrom = 0;
+    uint8_t moveTo = 0;
+
+    bool hasMove() const { return moveFrom != moveTo; }
+};
+
+/*
+TTSlot - wpis w pamięci tabeli, czytany i zapisywany bez blokad przez wiele wątków
+co wie: dane wpisu spakowane w 64 bity i klucz XOR dane
+Wątek może przeczytać połowę starego i połowę nowego wpisu - wtedy klucz XOR dane się nie zgadza
+i wpis jest traktowany jak nietrafiony.
+*/
+struct TTSlot {
+    std::atomic<uint64_t> keyXorData{0};
+    std::atomic<uint64_t> data{0};
+};
+
+// jeden kubełek = jedna linia cache (64 bajty)
+struct alignas(64) TTBucket {
+    static const int DEPTH_SLOTS = 3;  // wpisy 0-2: zastępowane, gdy nowy jest co najmniej tak głęboki
+    TTSlot entries[DEPTH_SLOTS + 1];   // wpis 3: zastępowany zawsze
+};
+
+/*
+TranspositionTable - tabela transpozycji o stałym rozmiarze (potęga dwójki kubełków)
+co umie:
+    * zmienia rozmiar (w MB) i czyści się
+    * szuka wpisu po kluczu
+    * zapisuje wynik (depth-preferred + always-replace)
+probe i store można wołać z wielu wątków naraz (Lazy SMP), resize i clear - nie
+*/
+class TranspositionTable {
+private:
+    std::unique_ptr<TTBucket[]> buckets;
+    size_t count = 0;
+    uint64_t mask = 0;
+
+    static uint64_t pack(const TTEntry& entry);
+    static TTEntry unpack(uint64_t key, uint64_t data);
+    // odczyt wpisu; false, gdy pusty albo rozerwany przez równoległy zapis
+    static bool read(const TTSlot& slot, uint64_t& key, TTEntry& entry);
+
+public:
+    explicit TranspositionTable(size_t megabytes = 64);
+    void resize(size_t megabytes);
+    void clear();
+    bool probe(uint64_t key, TTEntry& result) const;
+    void store(uint64_t key, int depth, int score, Bound bound, int moveFrom, int moveTo);
+    size_t getSizeInMB() const;
+};
+
+#endif
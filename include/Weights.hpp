@@ -0,0 +1,68 @@
+#ifndef WEIGHTS_H
+#define WEIGHTS_H
+
+#include "Piece.hpp"
+
+// wagi
+const int PIECE_VALUE = 100;
+const int KING_VALUE = 300;
+const int MOBILITY_WEIGHT = 5;
+const int ADVANCEMENT_WEIGHT = 3;
+const int CENTER_CONTROL_WEIGHT = 2;
+const int EDGE_PENALTY = -10;
+const int BACK_ROW_BONUS = 5;
+
+// tabela wag (w środku większe)
+constexpr int POSITION_TABLE[8][8] = {
+    {0, 1, 0, 1, 0, 1, 0, 1},
+    {1, 0, 2, 0, 2, 0, 2, 0},
+    {0, 2, 0, 3, 0, 3, 0, 2},
+    {1, 0, 3, 0, 4, 0, 3, 0},
+    {0, 3, 0, 4, 0, 3, 0, 1},
+    {2, 0, 3, 0, 3, 0, 2, 0},
+    {0, 2, 0, 2, 0, 2, 0, 1},
+    {1, 0, 1, 0, 1, 0, 1, 0}
+};
+
+// Statyczna wartość pionka na polu (materiał, pozycja, przesunięcie, krawędź, ostatni rząd) z perspektywy
+// czarnych - białe mają wartości ujemne. Wszystkie te składniki są sumą po pionkach, więc Bitboard trzyma
+// ich sumę i poprawia ją przy każdej zmianie, a evaluateBoard tylko ją odczytuje.
+// Indeks jak w kluczach Zobrista: pole x (kolor * 2 + damka)
+struct PieceSquareScores {
+    int value[32][4];
+};
+
+constexpr PieceSquareScores makePieceSquareScores() {
+    PieceSquareScores t{};
+    for (int sq = 0; sq < 32; ++sq) {
+        int row = sq / 4;
+        int col = (sq % 4) * 2 + (row + 1) % 2;
+        for (int kind = 0; kind < 4; ++kind) {
+            bool isBlack = kind / 2 == static_cast<int>(Piececolor::Black);
+            bool isKing = kind % 2 == 1;
+
+            int pieceValue = isKing ? KING_VALUE : PIECE_VALUE;
+            // Premia za pozycję na planszy
+            int positionBonus = POSITION_TABLE[row][col] * CENTER_CONTROL_WEIGHT;
+            // Premia za przesunięcie pionka do przodu
+            int advancementBonus = 0;
+            if (!isKing) advancementBonus = (isBlack ? 7 - row : row) * ADVANCEMENT_WEIGHT;
+            // Kara za pionki na krawędzi (jeśli nie są damkami)
+            int edgePenalty = (!isKing && (col == 0 || col == 7)) ? EDGE_PENALTY : 0;
+            // Premia za ochronę ostatniego rzędu
+            int backRowBonus = (!isKing && ((isBlack && row == 7) || (!isBlack && row == 0))) ? BACK_ROW_BONUS : 0;
+
+            int totalValue = pieceValue + positionBonus + advancementBonus + edgePenalty + backRowBonus;
+            t.value[sq][kind] = isBlack ? totalValue : -totalValue;
+        }
+    }
+    return t;
+}
+
+inline constexpr PieceSquareScores PIECE_SQUARE_SCORES = makePieceSquareScores();
+
+inline int pieceSquareScore(int sq, Piececolor color, bool isKing) {
+    return PIECE_SQUARE_SCORES.value[sq][static_cast<int>(color) * 2 + (isKing ? 1 : 0)];
+}
+
+#endif
@@ -0,0 +1,37 @@
+#include "../include/AIWorker.hpp"
+#include <chrono>
+
+AIWorker::~AIWorker() {
+    cancel();
+}
+
+void AIWorker::start(const Bitboard& snapshot, int maxDepth, int timeLimitMs, int threads) {
+    cancel();
+    cancelRequested = false;
+
+    SearchLimits limits;
+    limits.maxDepth = maxDepth;
+    limits.timeLimitMs = timeLimitMs;
+    limits.cancel = &cancelRequested;
+    limits.threads = threads;
+    limits.useOpeningBook = true;
+
+    pending = std::async(std::launch::async, [snapshot, limits]() {
+        return searchBestMove(snapshot, limits);
+    });
+}
+
+std::optional<SearchResult> AIWorker::poll() {
+    if (!pending.valid() || pending.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return std::nullopt;
+    }
+    return pending.get();
+}
+
+void AIWorker::cancel() {
+    if (!pending.valid()) return;
+    cancelRequested = true;
+    // przeszukiwanie sprawdza flagę co 1024 węzły, więc czekamy najwyżej chwilę
+    pending.wait();
+    pending = std::future<SearchResult>();
+}
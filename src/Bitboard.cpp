@@ -0,0 +1,389 @@
+#include "../include/Bitboard.hpp"
+
+void Bitboard::clear() {
+    white = black = kings = 0;
+    hash = computeHash();
+    staticScore = computeStaticScore();
+}
+
+void Bitboard::initialize() {
+    // czarne w rzędach 0-2, białe w rzędach 5-7
+    black = 0x00000FFFu;
+    white = 0xFFF00000u;
+    kings = 0;
+    currentPlayer = Piececolor::White;
+    hash = computeHash();
+    staticScore = computeStaticScore();
+}
+
+void Bitboard::setPosition(uint32_t whitePieces, uint32_t blackPieces, uint32_t kingPieces, Piececolor toMove) {
+    assert(!(whitePieces & blackPieces) && !(kingPieces & ~(whitePieces | blackPieces)));
+    white = whitePieces;
+    black = blackPieces;
+    kings = kingPieces;
+    currentPlayer = toMove;
+    hash = computeHash();
+    staticScore = computeStaticScore();
+}
+
+uint64_t Bitboard::computeHash() const {
+    uint64_t key = (currentPlayer == Piececolor::Black) ? ZOBRIST.blackToMove : 0;
+    for (uint32_t bb = getOccupied(); bb; bb &= bb - 1) {
+        int sq = lowestSquare(bb);
+        Piececolor color = (white & squareBit(sq)) ? Piececolor::White : Piececolor::Black;
+        key ^= zobristPiece(sq, color, kings & squareBit(sq));
+    }
+    return key;
+}
+
+int Bitboard::computeStaticScore() const {
+    int score = 0;
+    for (uint32_t bb = getOccupied(); bb; bb &= bb - 1) {
+        int sq = lowestSquare(bb);
+        Piececolor color = (white & squareBit(sq)) ? Piececolor::White : Piececolor::Black;
+        score += pieceSquareScore(sq, color, kings & squareBit(sq));
+    }
+    return score;
+}
+
+void Bitboard::setCurrentPlayer(Piececolor color) {
+    if (color != currentPlayer) hash ^= ZOBRIST.blackToMove;
+    currentPlayer = color;
+    checkIncremental();
+}
+
+std::optional<Piece> Bitboard::getPiece(int sq) const {
+    uint32_t b = squareBit(sq);
+    if (!(getOccupied() & b)) return std::nullopt;
+    Piececolor color = (white & b) ? Piececolor::White : Piececolor::Black;
+    return Piece(color, (kings & b) ? Piecetype::King : Piecetype::Man);
+}
+
+void Bitboard::setPiece(int sq, const Piece& piece) {
+    removePiece(sq);
+    uint32_t b = squareBit(sq);
+    if (piece.getColor() == Piececolor::White) white |= b;
+    else black |= b;
+    if (piece.isKing()) kings |= b;
+    togglePiece(sq, piece.getColor(), piece.isKing(), +1);
+    checkIncremental();
+}
+
+void Bitboard::removePiece(int sq) {
+    std::optional<Piece> piece = getPiece(sq);
+    if (!piece) return;
+    togglePiece(sq, piece->getColor(), piece->isKing(), -1);
+    uint32_t b = ~squareBit(sq);
+    white &= b;
+    black &= b;
+    kings &= b;
+    checkIncremental();
+}
+
+void Bitboard::makeKing(int sq) {
+    std::optional<Piece> piece = getPiece(sq);
+    if (!piece || piece->isKing()) return;
+    togglePiece(sq, piece->getColor(), false, -1);
+    togglePiece(sq, piece->getColor(), true, +1);
+    kings |= squareBit(sq);
+    checkIncremental();
+}
+
+namespace {
+
+// bicia pionków w kierunku Dir: wszystkie naraz
+template <int Dir>
+void addManCaptures(uint32_t men, uint32_t enemy, uint32_t empty, MoveList& moves) {
+    constexpr int back = 3 - Dir;
+    uint32_t targets = shiftDirection<Dir>(shiftDirection<Dir>(men) & enemy) & empty;
+    for (; targets; targets &= targets - 1) {
+        int to = lowestSquare(targets);
+        int mid = BB_TABLES.neighbor[to][back];
+        Move m(squarePosition(BB_TABLES.neighbor[mid][back]), squarePosition(to));
+        m.addCaptured(squarePosition(mid));
+        moves.push_back(m);
+    }
+}
+
+template <int Dir>
+void addManSteps(uint32_t men, uint32_t empty, MoveList& moves) {
+    constexpr int back = 3 - Dir;
+    for (uint32_t targets = shiftDirection<Dir>(men) & empty; targets; targets &= targets - 1) {
+        int to = lowestSquare(targets);
+        moves.emplace_back(squarePosition(BB_TABLES.neighbor[to][back]), squarePosition(to));
+    }
+}
+
+template <int Dir>
+int countManCaptures(uint32_t men, uint32_t enemy, uint32_t empty) {
+    return popCount(shiftDirection<Dir>(shiftDirection<Dir>(men) & enemy) & empty);
+}
+
+} // namespace
+
+template <Piececolor Color>
+MoveList Bitboard::getAllValidMoves() const {
+    MoveList moves;
+    // bicie jest obowiązkowe - zwykłe ruchy tylko gdy nie ma żadnego bicia
+    addCaptureMoves<Color>(moves);
+    if (moves.empty()) {
+        addQuietMoves<Color>(moves);
+    }
+    return moves;
+}
+
+template <Piececolor Color>
+void Bitboard::addCaptureMoves(MoveList& moves) const {
+    constexpr int firstDir = manFirstDirection(Color);
+    uint32_t own = getPieces<Color>();
+    uint32_t enemy = getPieces<opponent(Color)>();
+    uint32_t empty = getEmpty();
+    uint32_t men = own & ~kings;
+
+    // pionki: wszystkie bicia w danym kierunku naraz
+    addManCaptures<firstDir>(men, enemy, empty, moves);
+    addManCaptures<firstDir + 1>(men, enemy, empty, moves);
+
+    // damki: pierwszy napotkany pionek na promieniu musi być przeciwnika, za nim wolne pola
+    uint32_t occupied = getOccupied();
+    for (uint32_t bb = own & kings; bb; bb &= bb - 1) {
+        int from = lowestSquare(bb);
+        for (int dir = 0; dir < 4; ++dir) {
+            uint32_t blockers = BB_TABLES.ray[from][dir] & occupied;
+            if (!blockers) continue;
+            int mid = firstBlocker(blockers, dir);
+            if (!(enemy & squareBit(mid))) continue;
+
+            uint32_t beyond = BB_TABLES.ray[mid][dir];
+            uint32_t next = beyond & occupied;
+            uint32_t landing = next ? beyond & ~(BB_TABLES.ray[firstBlocker(next, dir)][dir] | next) : beyond;
+            for (; landing; landing &= landing - 1) {
+                Move m(squarePosition(from), squarePosition(lowestSquare(landing)));
+                m.addCaptured(squarePosition(mid));
+                moves.push_back(m);
+            }
+        }
+    }
+}
+
+template <Piececolor Color>
+void Bitboard::addQuietMoves(MoveList& moves) const {
+    constexpr int firstDir = manFirstDirection(Color);
+    uint32_t own = getPieces<Color>();
+    uint32_t empty = getEmpty();
+    uint32_t men = own & ~kings;
+
+    addManSteps<firstDir>(men, empty, moves);
+    addManSteps<firstDir + 1>(men, empty, moves);
+
+    uint32_t occupied = getOccupied();
+    for (uint32_t bb = own & kings; bb; bb &= bb - 1) {
+        int from = lowestSquare(bb);
+        for (int dir = 0; dir < 4; ++dir) {
+            uint32_t ray = BB_TABLES.ray[from][dir];
+            uint32_t blockers = ray & occupied;
+            if (blockers) {
+                int blocker = firstBlocker(blockers, dir);
+                ray &= ~(BB_TABLES.ray[blocker][dir] | squareBit(blocker));
+            }
+            for (; ray; ray &= ray - 1) {
+                moves.emplace_back(squarePosition(from), squarePosition(lowestSquare(ray)));
+            }
+        }
+    }
+}
+
+template <Piececolor Color>
+int Bitboard::countCaptureMoves() const {
+    constexpr int firstDir = manFirstDirection(Color);
+    uint32_t own = getPieces<Color>();
+    uint32_t enemy = getPieces<opponent(Color)>();
+    uint32_t empty = getEmpty();
+    uint32_t men = own & ~kings;
+    int count = countManCaptures<firstDir>(men, enemy, empty) + countManCaptures<firstDir + 1>(men, enemy, empty);
+
+    uint32_t occupied = getOccupied();
+    for (uint32_t bb = own & kings; bb; bb &= bb - 1) {
+        int from = lowestSquare(bb);
+        for (int dir = 0; dir < 4; ++dir) {
+            uint32_t blockers = BB_TABLES.ray[from][dir] & occupied;
+            if (!blockers) continue;
+            int mid = firstBlocker(blockers, dir);
+            if (!(enemy & squareBit(mid))) continue;
+
+            uint32_t beyond = BB_TABLES.ray[mid][dir];
+            uint32_t next = beyond & occupied;
+            count += popCount(next ? beyond & ~(BB_TABLES.ray[firstBlocker(next, dir)][dir] | next) : beyond);
+        }
+    }
+    return count;
+}
+
+template <Piececolor Color>
+int Bitboard::countQuietMoves() const {
+    constexpr int firstDir = manFirstDirection(Color);
+    uint32_t own = getPieces<Color>();
+    uint32_t empty = getEmpty();
+    uint32_t men = own & ~kings;
+    int count = popCount(shiftDirection<firstDir>(men) & empty) + popCount(shiftDirection<firstDir + 1>(men) & empty);
+
+    uint32_t occupied = getOccupied();
+    for (uint32_t bb = own & kings; bb; bb &= bb - 1) {
+        int from = lowestSquare(bb);
+        for (int dir = 0; dir < 4; ++dir) {
+            uint32_t ray = BB_TABLES.ray[from][dir];
+            uint32_t blockers = ray & occupied;
+            if (blockers) {
+                int blocker = firstBlocker(blockers, dir);
+                ray &= ~(BB_TABLES.ray[blocker][dir] | squareBit(blocker));
+            }
+            count += popCount(ray);
+        }
+    }
+    return count;
+}
+
+template <Piececolor Color>
+int Bitboard::countMoves() const {
+    int captures = countCaptureMoves<Color>();
+    return captures ? captures : countQuietMoves<Color>();
+}
+
+template <Piececolor Color>
+bool Bitboard::hasAnyMove() const {
+    constexpr int firstDir = manFirstDirection(Color);
+    uint32_t own = getPieces<Color>();
+    uint32_t empty = getEmpty();
+    uint32_t men = own & ~kings;
+    uint32_t ownKings = own & kings;
+
+    // zwykły krok pionka albo damki na sąsiednie wolne pole
+    uint32_t steps = shiftDirection<firstDir>(men) | shiftDirection<firstDir + 1>(men) |
+                     shiftDirection<0>(ownKings) | shiftDirection<1>(ownKings) |
+                     shiftDirection<2>(ownKings) | shiftDirection<3>(ownKings);
+    if (steps & empty) return true;
+    // bez wolnego sąsiedniego pola zostaje tylko bicie
+    return countCaptureMoves<Color>() > 0;
+}
+
+template <Piececolor Color>
+UndoInfo Bitboard::applyMove(const Move& move) {
+    constexpr Piececolor enemy = opponent(Color);
+    UndoInfo undo;
+    undo.previousPlayer = currentPlayer;
+    undo.previousHash = hash;
+    undo.previousStaticScore = staticScore;
+
+    int fromSq = move.getFromSquare();
+    int toSq = move.getToSquare();
+    uint32_t fromTo = squareBit(fromSq) | squareBit(toSq);
+    assert(getPieces<Color>() & squareBit(fromSq));
+
+    bool wasKing = kings & squareBit(fromSq);
+    piecesOf<Color>() ^= fromTo;
+    if (wasKing) kings ^= fromTo;
+    togglePiece(fromSq, Color, wasKing, -1);
+
+    undo.captured = move.getCapturedMask();
+    for (uint32_t bb = undo.captured; bb; bb &= bb - 1) {
+        int sq = lowestSquare(bb);
+        togglePiece(sq, enemy, kings & squareBit(sq), -1);
+    }
+    undo.capturedKings = undo.captured & kings;
+    piecesOf<enemy>() &= ~undo.captured;
+    kings &= ~undo.captured;
+
+    if (!wasKing && move.getTo().row == promotionRow(Color)) {
+        kings |= squareBit(toSq);
+        undo.promoted = true;
+    }
+    togglePiece(toSq, Color, kings & squareBit(toSq), +1);
+
+    // zmieniamy gracza
+    currentPlayer = opponent(currentPlayer);
+    hash ^= ZOBRIST.blackToMove;
+    checkIncremental();
+    return undo;
+}
+
+template <Piececolor Color>
+void Bitboard::undoMove(const Move& move, const UndoInfo& undo) {
+    int fromSq = move.getFromSquare();
+    int toSq = move.getToSquare();
+    uint32_t fromTo = squareBit(fromSq) | squareBit(toSq);
+
+    if (undo.promoted) kings &= ~squareBit(toSq);
+    if (kings & squareBit(toSq)) kings ^= fromTo;
+    piecesOf<Color>() ^= fromTo;
+    piecesOf<opponent(Color)>() |= undo.captured;
+    kings |= undo.capturedKings;
+
+    currentPlayer = undo.previousPlayer;
+    hash = undo.previousHash;
+    staticScore = undo.previousStaticScore;
+    checkIncremental();
+}
+
+// wersje z kolorem w argumencie
+MoveList Bitboard::getAllValidMoves(Piececolor playerColor) const {
+    return (playerColor == Piececolor::White) ? getAllValidMoves<Piececolor::White>()
+                                              : getAllValidMoves<Piececolor::Black>();
+}
+
+void Bitboard::addCaptureMoves(Piececolor playerColor, MoveList& moves) const {
+    if (playerColor == Piececolor::White) addCaptureMoves<Piececolor::White>(moves);
+    else addCaptureMoves<Piececolor::Black>(moves);
+}
+
+void Bitboard::addQuietMoves(Piececolor playerColor, MoveList& moves) const {
+    if (playerColor == Piececolor::White) addQuietMoves<Piececolor::White>(moves);
+    else addQuietMoves<Piececolor::Black>(moves);
+}
+
+int Bitboard::countCaptureMoves(Piececolor playerColor) const {
+    return (playerColor == Piececolor::White) ? countCaptureMoves<Piececolor::White>()
+                                              : countCaptureMoves<Piececolor::Black>();
+}
+
+int Bitboard::countQuietMoves(Piececolor playerColor) const {
+    return (playerColor == Piececolor::White) ? countQuietMoves<Piececolor::White>()
+                                              : countQuietMoves<Piececolor::Black>();
+}
+
+int Bitboard::countMoves(Piececolor playerColor) const {
+    return (playerColor == Piececolor::White) ? countMoves<Piececolor::White>() : countMoves<Piececolor::Black>();
+}
+
+bool Bitboard::hasAnyMove(Piececolor playerColor) const {
+    return (playerColor == Piececolor::White) ? hasAnyMove<Piececolor::White>() : hasAnyMove<Piececolor::Black>();
+}
+
+// kolor ruszającego się pionka odczytany z pola startowego
+UndoInfo Bitboard::applyMove(const Move& move) {
+    if (white & squareBit(move.getFromSquare())) return applyMove<Piececolor::White>(move);
+    return applyMove<Piececolor::Black>(move);
+}
+
+void Bitboard::undoMove(const Move& move, const UndoInfo& undo) {
+    if (white & squareBit(move.getToSquare())) undoMove<Piececolor::White>(move, undo);
+    else undoMove<Piececolor::Black>(move, undo);
+}
+
+template MoveList Bitboard::getAllValidMoves<Piececolor::White>() const;
+template MoveList Bitboard::getAllValidMoves<Piececolor::Black>() const;
+template void Bitboard::addCaptureMoves<Piececolor::White>(MoveList&) const;
+template void Bitboard::addCaptureMoves<Piececolor::Black>(MoveList&) const;
+template void Bitboard::addQuietMoves<Piececolor::White>(MoveList&) const;
+template void Bitboard::addQuietMoves<Piececolor::Black>(MoveList&) const;
+template int Bitboard::countCaptureMoves<Piececolor::White>() const;
+template int Bitboard::countCaptureMoves<Piececolor::Black>() const;
+template int Bitboard::countQuietMoves<Piececolor::White>() const;
+template int Bitboard::countQuietMoves<Piececolor::Black>() const;
+template int Bitboard::countMoves<Piececolor::White>() const;
+template int Bitboard::countMoves<Piececolor::Black>() const;
+template bool Bitboard::hasAnyMove<Piececolor::White>() const;
+template bool Bitboard::hasAnyMove<Piececolor::Black>() const;
+template UndoInfo Bitboard::applyMove<Piececolor::White>(const Move&);
+template UndoInfo Bitboard::applyMove<Piececolor::Black>(const Move&);
+template void Bitboard::undoMove<Piececolor::White>(const Move&, const UndoInfo&);
+template void Bitboard::undoMove<Piececolor::Black>(const Move&, const UndoInfo&);
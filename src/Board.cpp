@@ -1,4 +1,5 @@
 #include "../include/Board.hpp"
+#include "../include/Trace.hpp"
 #include <cmath>
 #include <algorithm>
 #include <iostream>
@@ -7,27 +8,37 @@ Board::Board() {}
 Board::~Board() {}
 
 void Board::initialize() {
+    position.initialize();
     for (int row = 0; row < SIZE; ++row) {
         for (int col = 0; col < SIZE; ++col) {
-            tiles[row][col].removePiece();
+            syncTile(row, col);
         }
     }
+}
 
-    
-    for (int row = 0; row < 3; ++row) {
-        for (int col = 0; col < SIZE; ++col) {
-            if ((row + col) % 2 == 1) {
-                tiles[row][col].setPiece(Piececolor::Black);
-            }
-        }
-    }
-    for (int row = SIZE - 3; row < SIZE; ++row) {
-        for (int col = 0; col < SIZE; ++col) {
-            if ((row + col) % 2 == 1) {
-                tiles[row][col].setPiece(Piececolor::White);
-            }
-        }
+void Board::syncTile(int row, int col) {
+    if ((row + col) % 2 == 0) {
+        tiles[row][col].removePiece();
+        return;
     }
+    std::optional<Piece> piece = position.getPiece(squareIndex(row, col));
+    if (piece) tiles[row][col].setPiece(*piece);
+    else tiles[row][col].removePiece();
+}
+
+void Board::setPiece(int row, int col, const Piece& piece) {
+    position.setPiece(squareIndex(row, col), piece);
+    syncTile(row, col);
+}
+
+void Board::removePiece(int row, int col) {
+    position.removePiece(squareIndex(row, col));
+    syncTile(row, col);
+}
+
+void Board::makeKing(int row, int col) {
+    position.makeKing(squareIndex(row, col));
+    syncTile(row, col);
 }
 
 Tile& Board::getTile(int row, int col) {
@@ -122,175 +133,30 @@ bool Board::isValidMove(const Move& move, Piececolor playerColor) const {
 }
 
 std::vector<Move> Board::getAllValidMoves(Piececolor playercolor) const {
-    std::vector<Move> captureMoves;
-    std::vector<Move> normalMoves;
-    const std::vector<std::pair<int, int>> directions = {
-        {-1, -1}, {-1, 1}, {1, -1}, {1, 1}
-    };
-
-    for (int row = 0; row < SIZE; ++row) {
-        for (int col = 0; col < SIZE; ++col) {
-            const Tile& tile = getTile(row, col);
-            if (!tile.hasPiece()) continue;
-
-            const Piece* piece = tile.getPiece();
-            if (piece->getColor() != playercolor) continue;
-
-            Position from = {row, col};
-
-            
-            std::vector<Move> multiCaptures;
-            Move baseMove(from, from);
-            findMultiCaptures(from, {}, multiCaptures, playercolor, piece->getType(), baseMove);
-
-            captureMoves.insert(captureMoves.end(), multiCaptures.begin(), multiCaptures.end());
-
-            if (piece->getType() == Piecetype::Man) {
-                int dir = (playercolor == Piececolor::White) ? -1 : 1;
-                for (int dc : {-1, 1}) {
-                    Position to = {row + dir, col + dc};
-                    Move m(from, to);
-                    if (isValidMove(m, playercolor)) normalMoves.push_back(m);
-                }
-            } else if (piece->getType() == Piecetype::King) {
-                for (auto [dr, dc] : directions) {
-                    for (int step = 1; step < 8; ++step) {
-                        int newRow = row + step * dr;
-                        int newCol = col + step * dc;
-                        if (newRow < 0 || newRow >= SIZE || newCol < 0 || newCol >= SIZE) break;
-                        Position to = {newRow, newCol};
-                        Move m(from, to);
-                        if (isValidMove(m, playercolor)) normalMoves.push_back(m);
-                        if (getTile(newRow, newCol).hasPiece()) break;
-                    }
-                }
-            }
-        }
-    }
-
-    return !captureMoves.empty() ? captureMoves : normalMoves;
+    TraceScope trace("getAllValidMoves", "movegen");
+    return position.getAllValidMoves(playercolor).toVector();
 }
 
-void Board::findMultiCaptures(Position from,
-                               std::vector<Position> captured,
-                               std::vector<Move>& result,
-                               Piececolor color,
-                               Piecetype type,
-                               const Move& currentMove) const {
-    bool foundExtension = false;
-
-    const std::vector<std::pair<int, int>> directions = {
-        {-1, -1}, {-1, 1}, {1, -1}, {1, 1}
-    };
-
-    for (auto [dr, dc] : directions) {
-        if (type == Piecetype::Man) {
-            int midRow = from.row + dr;
-            int midCol = from.col + dc;
-            int destRow = from.row + 2 * dr;
-            int destCol = from.col + 2 * dc;
-
-            if (destRow < 0 || destRow >= SIZE || destCol < 0 || destCol >= SIZE) continue;
-
-            Position mid = {midRow, midCol};
-            Position dest = {destRow, destCol};
-
-            if (std::find(captured.begin(), captured.end(), mid) != captured.end()) continue;
-
-            Move candidate(from, dest);
-            candidate.addCaptured(mid);
-
-            if (isValidMove(candidate, color)) {
-                Move newMove(currentMove.getFrom(), dest);
-                for (const Position& cap : currentMove.getCaptured()) {
-                    newMove.addCaptured(cap);
-                }
-                newMove.addCaptured(mid);
-
-                std::vector<Position> newCaptured = captured;
-                newCaptured.push_back(mid);
-
-                findMultiCaptures(dest, newCaptured, result, color, type, newMove);
-                foundExtension = true;
-            }
-        }
-        else if (type == Piecetype::King) {
-            for (int step = 1; step < SIZE; ++step) {
-                int midRow = from.row + dr * step;
-                int midCol = from.col + dc * step;
-                if (midRow < 0 || midRow >= SIZE || midCol < 0 || midCol >= SIZE) break;
-
-                const Tile& midTile = getTile(midRow, midCol);
-                if (!midTile.hasPiece()) continue;
-
-                const Piece* p = midTile.getPiece();
-                if (p->getColor() == color) break;
-
-                Position mid = {midRow, midCol};
-                if (std::find(captured.begin(), captured.end(), mid) != captured.end()) break;
-
-                int nextRow = midRow + dr;
-                int nextCol = midCol + dc;
-
-                while (nextRow >= 0 && nextRow < SIZE &&
-                       nextCol >= 0 && nextCol < SIZE &&
-                       !getTile(nextRow, nextCol).hasPiece()) {
-                    Position dest = {nextRow, nextCol};
-                    Move candidate(from, dest);
-                    candidate.addCaptured(mid);
-
-                    if (isValidMove(candidate, color)) {
-                        Move newMove(currentMove.getFrom(), dest);
-                        for (const Position& cap : currentMove.getCaptured()) {
-                            newMove.addCaptured(cap);
-                        }
-                        newMove.addCaptured(mid);
-
-                        std::vector<Position> newCaptured = captured;
-                        newCaptured.push_back(mid);
-
-                        findMultiCaptures(dest, newCaptured, result, color, type, newMove);
-                        foundExtension = true;
-                    }
-
-                    nextRow += dr;
-                    nextCol += dc;
-                }
-                break;
-            }
-        }
-    }
-
-    if (!foundExtension && !currentMove.getCaptured().empty()) {
-        result.push_back(currentMove);
-    }
-}
-
-
 /*bool Board::isInsideBoard(int row, int col) const {
     return row >= 0 && row < SIZE && col >= 0 && col < SIZE;
 }*/
 
 
-void Board::applyMove(const Move& move) {
-    Tile& fromTile = tiles[move.getFrom().row][move.getFrom().col];
-    Tile& toTile = tiles[move.getTo().row][move.getTo().col];
+UndoInfo Board::applyMove(const Move& move) {
+    UndoInfo undo = position.applyMove(move);
+    syncMoveTiles(move);
+    return undo;
+}
 
-    if (fromTile.hasPiece()) {
-        toTile.setPiece(*(fromTile.getPiece()));
-        fromTile.removePiece();
-    }
+void Board::undoMove(const Move& move, const UndoInfo& undo) {
+    position.undoMove(move, undo);
+    syncMoveTiles(move);
+}
 
+void Board::syncMoveTiles(const Move& move) {
+    syncTile(move.getFrom().row, move.getFrom().col);
+    syncTile(move.getTo().row, move.getTo().col);
     for (const Position& capturedPos : move.getCaptured()) {
-        tiles[capturedPos.row][capturedPos.col].removePiece();
-    }
-
-    Piece& movedPiece = *(toTile.getPiece());
-    if ((movedPiece.getColor() == Piececolor::White && move.getTo().row == 0) ||
-        (movedPiece.getColor() == Piececolor::Black && move.getTo().row == 7)) {
-        movedPiece.makeKing();
+        syncTile(capturedPos.row, capturedPos.col);
     }
-
-    // zmieniamy gracza
-    currentPlayer = (currentPlayer == Piececolor::White) ? Piececolor::Black : Piececolor::White;
 }
\ No newline at end of file
@@ -13,26 +13,8 @@ void Game::nextTurn() {
         // Zwycięzca — przeciwny gracz
         return;
     } else {
-        const Move& chosenMove = moves[0];
-        board.applyMove(chosenMove);
-
-        if (chosenMove.isCapture()) {
-            std::vector<Move> multiCaptures;
-            Move baseMove(chosenMove.getTo(), chosenMove.getTo());
-            board.findMultiCaptures(
-                chosenMove.getTo(),
-                {},
-                multiCaptures,
-                currentPlayer,
-                board.getTile(chosenMove.getTo().row, chosenMove.getTo().col).getPiece()->getType(),
-                baseMove
-            );
-            // jeśli są kolejne bicie — kontynuować tą samą figurą
-            if (!multiCaptures.empty()) {
-                return;
-            }
-        }
-        // jeśli nie było wielokrotnego bicia — zmieniamy gracza
+        // bicie jest pojedyncze, więc ruch zawsze kończy turę
+        board.applyMove(moves[0]);
         currentPlayer = (currentPlayer == Piececolor::White) ? Piececolor::Black : Piececolor::White;
     }
 }
@@ -1,263 +1,399 @@
+#include <algorithm>
 #include <chrono>
-#include <iostream>
-#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <iomanip>
-#include "../include/Board.hpp"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
 #include "../include/AI.hpp"
+#include "../include/Notation.hpp"
+
+/*
+Measure - benchmark silnika na stałym zestawie pozycji; nic nie pyta, więc nadaje się do skryptów.
+Użycie: Measure [opcje]
+    --depth N       maksymalna głębokość (domyślnie 10)
+    --time MS       limit czasu na ruch, 0 - bez limitu (domyślnie 0)
+    --threads N     wątki przeszukiwania (domyślnie 1)
+    --mode M        lazy | root | ybwc - podział pracy przy kilku wątkach (domyślnie lazy)
+    --qply N        limit ply wyszukiwania spoczynkowego, 0 - wyłączone (domyślnie 12)
+    --reps N        powtórzenia każdej pozycji (domyślnie 3)
+    --category C    tylko pozycje z kategorii: opening, middlegame, kings, endgame
+    --scaling       ten sam zestaw dla 1, 2, 4... aż do --threads wątków (przyspieszenie)
+    --json PLIK     wszystkie wyniki w JSON (razem z czasem dojścia do każdej głębokości)
+    --csv PLIK      wyniki w CSV, wiersz na jedno przeszukanie
+    --trace PLIK    przebieg wszystkich przeszukiwań w formacie Chrome trace (chrome://tracing, Perfetto);
+                    bufory śladu są ograniczone, więc przy długich seriach zostaje tylko koniec
+Przed każdym przeszukaniem tabela transpozycji jest czyszczona, żeby powtórzenia były niezależne.
+*/
 
-// struktura do przechowywania wyników pomiarów
-struct PerformanceResult {
-    int depth;
-    double averageTime;
-    double minTime;
-    double maxTime;
-    int totalMoves;
-    int nodesEvaluated;
+namespace {
+
+struct BenchmarkPosition {
+    const char* name;
+    const char* category;
+    const char* position;  // zapis z Notation.hpp; AI zawsze gra czarnymi
 };
 
-// Klasa do mierzenia wydajności
-class PerformanceMeasurer {
-private:
-    std::vector<PerformanceResult> results;
-    
-public:
-    // pomiar czasu jednego ruchu
-    double measureSingleMove(Board& board, int depth) {
-        std::vector<Move> moves = board.getAllValidMoves(Piececolor::Black);
-        if (moves.empty()) {
-            std::cout << "Brak dostępnych ruchów dla AI" << std::endl;
-            return -1.0;
-        }
-        
-        auto start = std::chrono::high_resolution_clock::now();
-        
-        try {
-            Move bestMove = findBestMove(board, depth);
-        } catch (const std::exception& e) {
-            std::cout << "Błąd podczas szukania ruchu: " << e.what() << std::endl;
-            return -1.0;
-        }
-        
-        auto end = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-        
-        return duration.count() / 1000.0; // ms
+const BenchmarkPosition CORPUS[] = {
+    {"opening-1",    "opening",    "B:W20,21,22,23,24,25,26,27,29,30,32:B2,3,4,5,7,8,9,11,12,14,15"},
+    {"opening-2",    "opening",    "B:W19,20,21,23,25,26,27,28,29,30,31:B1,2,3,4,6,7,11,12,13,14,16"},
+    {"opening-3",    "opening",    "B:W23,24,25,26,27,28,30,31,32:B1,2,3,4,6,8,11,12,14"},
+    {"middlegame-1", "middlegame", "B:W20,21,22,24,26,28,29,30:B1,2,8,10,14,15,17"},
+    {"middlegame-2", "middlegame", "B:W5,13,20,25,27,28,29,30:B2,3,4,6,8,14"},
+    {"middlegame-3", "middlegame", "B:W20,22,25,27,28,30:B2,3,4,7,9,11,16,18,21"},
+    {"middlegame-4", "middlegame", "B:W16,22,23,25,26,28,30:B2,3,4,8,9,10,20,21"},
+    {"kings-1",      "kings",      "B:WK3,K14,22,25,K29:BK7,11,K18,K27,5"},
+    {"kings-2",      "kings",      "B:WK1,K17,26,30:BK12,K20,9,5"},
+    {"kings-3",      "kings",      "B:WK3,19,20:BK25,26"},
+    {"endgame-1",    "endgame",    "B:W12,25,27,30:B3,18,21"},
+    {"endgame-2",    "endgame",    "B:WK4,16:B5,26"},
+    {"endgame-3",    "endgame",    "B:W21,29:B2,4,8,17,23"},
+};
+
+struct Options {
+    int depth = 10;
+    int timeMs = 0;
+    int threads = 1;
+    ParallelMode mode = ParallelMode::LazySmp;
+    int quiescencePly = DEFAULT_QUIESCENCE_PLY;
+    int reps = 3;
+    std::string category;
+    bool scaling = false;
+    std::string jsonPath;
+    std::string csvPath;
+    std::string tracePath;
+};
+
+// wynik jednego przeszukania
+struct BenchmarkRun {
+    const BenchmarkPosition* position;
+    int threads;
+    int rep;
+    double timeMs;
+    std::vector<SearchIteration> iterations;
+    OrderingStats ordering;  // cięcia beta całego przeszukania (wszystkie wątki)
+
+    int depth() const { return iterations.empty() ? 0 : iterations.back().depth; }
+    uint64_t nodes() const { return iterations.empty() ? 0 : iterations.back().nodes; }
+    // węzły na sekundę do końca ostatniej pełnej iteracji (przerwana iteracja się nie liczy)
+    double nps() const {
+        return iterations.empty() ? 0 : iterations.back().nodes / std::max(iterations.back().elapsedMs, 1e-3) * 1000.0;
     }
-    
-    // pomiar dla głębokości
-    PerformanceResult measureDepth(int depth, int numTests = 10) {
-        std::vector<double> times;
-        int successfulTests = 0;
-        
-        std::cout << "Testowanie głębokości " << depth << " (" << numTests << " testów)..." << std::endl;
-        
-        for (int i = 0; i < numTests; ++i) {
-            Board testBoard;
-            
-            testBoard.initialize();
-            
-            std::cout << "  Próba inicjalizacji planszy dla testu " << (i+1) << "..." << std::endl;
-            
-            double time = measureSingleMove(testBoard, depth);
-            
-            if (time >= 0) {
-                times.push_back(time);
-                successfulTests++;
-                std::cout << "  Test " << (i+1) << ": " << std::fixed << std::setprecision(2) 
-                         << time << " ms" << std::endl;
-            }
-        }
-        
-        PerformanceResult result;
-        result.depth = depth;
-        result.totalMoves = successfulTests;
-        
-        if (!times.empty()) {
-            double total = 0;
-            result.minTime = times[0];
-            result.maxTime = times[0];
-            
-            for (double time : times) {
-                total += time;
-                result.minTime = std::min(result.minTime, time);
-                result.maxTime = std::max(result.maxTime, time);
-            }
-            
-            result.averageTime = total / times.size();
+    // efektywny współczynnik rozgałęzienia: ile razy więcej węzłów kosztowała ostatnia głębokość od poprzedniej
+    double branchingFactor() const {
+        if (iterations.size() < 2 || iterations[iterations.size() - 2].nodes == 0) return 0;
+        return static_cast<double>(iterations.back().nodes) / iterations[iterations.size() - 2].nodes;
+    }
+};
+
+const char* modeName(ParallelMode mode) {
+    switch (mode) {
+        case ParallelMode::RootSplit: return "root";
+        case ParallelMode::Ybwc: return "ybwc";
+        default: return "lazy";
+    }
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string flag = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (flag == "--scaling") {
+            options.scaling = true;
+        } else if (flag == "--depth" && hasValue) {
+            options.depth = std::clamp(std::atoi(argv[++i]), 1, MAX_SEARCH_DEPTH);
+        } else if (flag == "--time" && hasValue) {
+            options.timeMs = std::max(0, std::atoi(argv[++i]));
+        } else if (flag == "--threads" && hasValue) {
+            options.threads = std::clamp(std::atoi(argv[++i]), 1, MAX_SEARCH_THREADS);
+        } else if (flag == "--qply" && hasValue) {
+            options.quiescencePly = std::clamp(std::atoi(argv[++i]), 0, MAX_PLY);
+        } else if (flag == "--reps" && hasValue) {
+            options.reps = std::max(1, std::atoi(argv[++i]));
+        } else if (flag == "--category" && hasValue) {
+            options.category = argv[++i];
+        } else if (flag == "--json" && hasValue) {
+            options.jsonPath = argv[++i];
+        } else if (flag == "--csv" && hasValue) {
+            options.csvPath = argv[++i];
+        } else if (flag == "--trace" && hasValue) {
+            options.tracePath = argv[++i];
+        } else if (flag == "--mode" && hasValue) {
+            std::string mode = argv[++i];
+            if (mode == "lazy") options.mode = ParallelMode::LazySmp;
+            else if (mode == "root") options.mode = ParallelMode::RootSplit;
+            else if (mode == "ybwc") options.mode = ParallelMode::Ybwc;
+            else return false;
         } else {
-            result.averageTime = result.minTime = result.maxTime = 0;
+            return false;
         }
-        
-        return result;
     }
-    
-    // testowanie wszystkich poziomów trudności
-    void runFullPerformanceTest() {
-        std::cout << "=== POMIAR WYDAJNOŚCI ALGORYTMU AI ===" << std::endl;
-        std::cout << std::endl;
-        
-        std::vector<int> depths = {1, 2, 3, 4, 5, 6}; 
-        
-        for (int depth : depths) {
-            PerformanceResult result = measureDepth(depth, 5); // 5 testów dla każdej głębokości
-            results.push_back(result);
-            std::cout << std::endl;
+    return true;
+}
+
+BenchmarkRun runSearch(const BenchmarkPosition& position, const Options& options, int threads, int rep) {
+    BenchmarkRun run{&position, threads, rep, 0, {}, {}};
+    Bitboard board;
+    parsePosition(position.position, board);
+    aiTranspositionTable().clear();
+
+    SearchLimits limits;
+    limits.maxDepth = options.depth;
+    limits.timeLimitMs = options.timeMs;
+    limits.threads = threads;
+    limits.parallelMode = options.mode;
+    limits.maxQuiescencePly = options.quiescencePly;
+    limits.onIteration = [&run](const SearchIteration& iteration) { run.iterations.push_back(iteration); };
+
+    auto start = std::chrono::steady_clock::now();
+    SearchResult result = searchBestMove(board, limits);
+    run.timeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    run.ordering = result.stats.ordering;
+    return run;
+}
+
+// percentyl metodą najbliższej pozycji (values posortowane)
+double percentile(const std::vector<double>& values, double p) {
+    if (values.empty()) return 0;
+    size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * values.size()));
+    return values[std::clamp<size_t>(rank, 1, values.size()) - 1];
+}
+
+void printRunTable(const std::vector<BenchmarkRun>& runs, int threads, const Options& options) {
+    std::cout << std::left << std::setw(14) << "Pozycja" << std::right
+              << std::setw(8) << "Gł."
+              << std::setw(12) << "Śr. (ms)"
+              << std::setw(12) << "Min (ms)"
+              << std::setw(12) << "Max (ms)"
+              << std::setw(14) << "Węzły"
+              << std::setw(10) << "kN/s"
+              << std::setw(8) << "EBF"
+              << std::setw(10) << "1. ruch"
+              << "  Ruch" << std::endl;
+    std::cout << std::string(110, '-') << std::endl;
+
+    std::vector<double> times;
+    uint64_t totalNodes = 0;
+    double totalSearchMs = 0;
+    OrderingStats totalOrdering;
+    for (const BenchmarkRun* first = runs.data(); first != runs.data() + runs.size(); ) {
+        if (first->threads != threads) { ++first; continue; }
+        // powtórzenia jednej pozycji leżą obok siebie
+        const BenchmarkRun* last = first;
+        while (last != runs.data() + runs.size() && last->position == first->position && last->threads == threads) ++last;
+
+        double sum = 0, minTime = first->timeMs, maxTime = first->timeMs, ebf = 0;
+        uint64_t nodes = 0;
+        OrderingStats ordering;
+        for (const BenchmarkRun* run = first; run != last; ++run) {
+            sum += run->timeMs;
+            minTime = std::min(minTime, run->timeMs);
+            maxTime = std::max(maxTime, run->timeMs);
+            nodes += run->nodes();
+            ebf += run->branchingFactor();
+            ordering.merge(run->ordering);
+            times.push_back(run->timeMs);
+            totalNodes += run->nodes();
+            totalSearchMs += run->iterations.empty() ? 0 : run->iterations.back().elapsedMs;
         }
-        
-        printResults();
-        saveResultsToFile("wyniki_wydajnosci.txt");
+        int count = static_cast<int>(last - first);
+        const SearchIteration* best = first->iterations.empty() ? nullptr : &first->iterations.back();
+
+        std::cout << std::left << std::setw(14) << first->position->name << std::right
+                  << std::setw(7) << first->depth()
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(12) << sum / count
+                  << std::setw(12) << minTime
+                  << std::setw(12) << maxTime
+                  << std::setw(14) << nodes / count
+                  << std::setprecision(0) << std::setw(10) << nodes / std::max(sum, 1e-3)
+                  << std::setprecision(2) << std::setw(8) << ebf / count
+                  << std::setprecision(1) << std::setw(9) << ordering.firstMoveCutoffRate() * 100 << "%"
+                  << "  " << (best ? formatMove(best->bestMove) : "-") << std::endl;
+        totalOrdering.merge(ordering);
+        first = last;
     }
-    
-    // wypisywanie w konsoli
-    void printResults() {
-        std::cout << "=== WYNIKI POMIARÓW ===" << std::endl;
-        std::cout << std::left << std::setw(10) << "Głębokość" 
-                  << std::setw(15) << "Średnia (ms)" 
-                  << std::setw(12) << "Min (ms)" 
-                  << std::setw(12) << "Max (ms)" 
-                  << std::setw(10) << "Testów" << std::endl;
-        std::cout << std::string(65, '-') << std::endl;
-        
-        for (const auto& result : results) {
-            std::cout << std::left << std::setw(10) << result.depth
-                      << std::setw(15) << std::fixed << std::setprecision(2) << result.averageTime
-                      << std::setw(12) << std::fixed << std::setprecision(2) << result.minTime
-                      << std::setw(12) << std::fixed << std::setprecision(2) << result.maxTime
-                      << std::setw(10) << result.totalMoves << std::endl;
-        }
-        
-        std::cout << std::endl;
-        analyzeComplexity();
+
+    std::sort(times.begin(), times.end());
+    std::cout << std::string(110, '-') << std::endl;
+    std::cout << "Wątki: " << threads << " (" << modeName(options.mode) << "), przeszukań: " << times.size()
+              << ", węzły: " << totalNodes
+              << std::setprecision(0) << ", N/s: " << totalNodes / std::max(totalSearchMs, 1e-3) * 1000.0
+              << std::setprecision(2) << ", p50: " << percentile(times, 50) << " ms, p90: " << percentile(times, 90)
+              << " ms, p99: " << percentile(times, 99) << " ms" << std::endl;
+
+    // jak dobrze działa kolejność ruchów: udział cięć na pierwszym ruchu i etap MovePicker ruchu tnącego
+    std::cout << std::setprecision(1) << "Cięcia beta: " << totalOrdering.betaCutoffs << ", na pierwszym ruchu "
+              << totalOrdering.firstMoveCutoffRate() * 100 << "%, wg etapu:";
+    for (int stage = 0; stage < PICK_STAGE_COUNT; ++stage) {
+        std::cout << " " << pickStageName(static_cast<PickStage>(stage)) << " "
+                  << 100.0 * totalOrdering.cutoffsByStage[stage] / std::max<uint64_t>(totalOrdering.betaCutoffs, 1) << "%";
     }
-    
-    void analyzeComplexity() {
-        std::cout << "=== ANALIZA ZŁOŻONOŚCI CZASOWEJ ===" << std::endl;
-        
-        if (results.size() >= 2) {
-            for (size_t i = 1; i < results.size(); ++i) {
-                if (results[i-1].averageTime > 0 && results[i].averageTime > 0) {
-                    double ratio = results[i].averageTime / results[i-1].averageTime;
-                    std::cout << "Stosunek czasu głębokości " << results[i].depth 
-                             << " do głębokości " << results[i-1].depth << ": " 
-                             << std::fixed << std::setprecision(2) << ratio << "x" << std::endl;
-                } else {
-                    std::cout << "Brak danych dla porównania głębokości " << results[i].depth 
-                             << " i " << results[i-1].depth << std::endl;
-                }
-            }
-            
-            std::cout << std::endl;
-            std::cout << "Teoretycznie dla minimax oczekiwany wzrost wykładniczy (~b^d)" << std::endl;
+    std::cout << std::setprecision(2) << std::endl;
+
+    // czas dojścia do głębokości (średnio po przeszukaniach, które do niej doszły)
+    std::cout << "Czas do głębokości (ms):";
+    for (int depth = 1; depth <= options.depth; ++depth) {
+        double sum = 0;
+        int count = 0;
+        for (const BenchmarkRun& run : runs) {
+            if (run.threads != threads || static_cast<int>(run.iterations.size()) < depth) continue;
+            sum += run.iterations[depth - 1].elapsedMs;
+            count++;
         }
+        if (count) std::cout << " " << depth << ":" << sum / count;
     }
-    
-    void saveResultsToFile(const std::string& filename) {
-        std::ofstream file(filename);
-        if (!file.is_open()) {
-            std::cout << "Nie udało się utworzyć pliku " << filename << std::endl;
-            return;
-        }
-        
-        file << "Wyniki pomiaru wydajności algorytmu AI dla warcabów\n";
-        file << "Data: " << getCurrentDateTime() << "\n\n";
-        
-        file << std::left << std::setw(10) << "Głębokość" 
-             << std::setw(15) << "Średnia (ms)" 
-             << std::setw(12) << "Min (ms)" 
-             << std::setw(12) << "Max (ms)" 
-             << std::setw(10) << "Testów" << "\n";
-        file << std::string(65, '-') << "\n";
-        
-        for (const auto& result : results) {
-            file << std::left << std::setw(10) << result.depth
-                 << std::setw(15) << std::fixed << std::setprecision(2) << result.averageTime
-                 << std::setw(12) << std::fixed << std::setprecision(2) << result.minTime
-                 << std::setw(12) << std::fixed << std::setprecision(2) << result.maxTime
-                 << std::setw(10) << result.totalMoves << "\n";
-        }
-        
-        file << "\nAnaliza złożoności czasowej:\n";
-        for (size_t i = 1; i < results.size(); ++i) {
-            double ratio = results[i].averageTime / results[i-1].averageTime;
-            file << "Stosunek czasu głębokości " << results[i].depth 
-                 << " do głębokości " << results[i-1].depth << ": " 
-                 << std::fixed << std::setprecision(2) << ratio << "x\n";
-        }
-        
-        file.close();
-        std::cout << "Wyniki zapisane w pliku: " << filename << std::endl;
+    std::cout << std::endl << std::endl;
+}
+
+double totalTime(const std::vector<BenchmarkRun>& runs, int threads) {
+    double total = 0;
+    for (const BenchmarkRun& run : runs) {
+        if (run.threads == threads) total += run.timeMs;
     }
-    
-private:
-    std::string getCurrentDateTime() {
-        auto now = std::chrono::system_clock::now();
-        auto time_t = std::chrono::system_clock::to_time_t(now);
-        std::stringstream ss;
-        ss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
-        return ss.str();
+    return total;
+}
+
+std::string jsonString(const std::string& text) {
+    std::string out = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
     }
-};
+    return out + "\"";
+}
+
+bool writeJson(const std::string& path, const std::vector<BenchmarkRun>& runs, const Options& options) {
+    std::ofstream file(path);
+    if (!file.is_open()) return false;
 
-// debug
-void debugBoardState() {
-    std::cout << "=== DEBUG: SPRAWDZANIE STANU PLANSZY ===" << std::endl;
-    
-    Board testBoard;
-    
-    testBoard.initialize();
-    
-    std::cout << "Sprawdzanie dostępnych ruchów dla czarnych..." << std::endl;
-    std::vector<Move> blackMoves = testBoard.getAllValidMoves(Piececolor::Black);
-    std::cout << "Liczba dostępnych ruchów dla czarnych: " << blackMoves.size() << std::endl;
-    
-    std::vector<Move> whiteMoves = testBoard.getAllValidMoves(Piececolor::White);
-    std::cout << "Liczba dostępnych ruchów dla białych: " << whiteMoves.size() << std::endl;
-    
-    if (!blackMoves.empty()) {
-        std::cout << "Próba wywołania findBestMove..." << std::endl;
-        try {
-            Move bestMove = findBestMove(testBoard, 1);
-            std::cout << "findBestMove zakończone pomyślnie!" << std::endl;
-        } catch (const std::exception& e) {
-            std::cout << "BŁĄD w findBestMove: " << e.what() << std::endl;
+    file << std::fixed << std::setprecision(3);
+    file << "{\n  \"config\": {\"depth\": " << options.depth << ", \"timeMs\": " << options.timeMs
+         << ", \"threads\": " << options.threads << ", \"mode\": " << jsonString(modeName(options.mode))
+         << ", \"quiescencePly\": " << options.quiescencePly << ", \"reps\": " << options.reps << "},\n  \"runs\": [";
+    for (size_t i = 0; i < runs.size(); ++i) {
+        const BenchmarkRun& run = runs[i];
+        file << (i ? ",\n" : "\n") << "    {\"position\": " << jsonString(run.position->name)
+             << ", \"category\": " << jsonString(run.position->category)
+             << ", \"fen\": " << jsonString(run.position->position)
+             << ", \"threads\": " << run.threads << ", \"rep\": " << run.rep
+             << ", \"timeMs\": " << run.timeMs << ", \"depth\": " << run.depth()
+             << ", \"nodes\": " << run.nodes() << ", \"nps\": " << run.nps()
+             << ", \"ebf\": " << run.branchingFactor()
+             << ", \"betaCutoffs\": " << run.ordering.betaCutoffs
+             << ", \"firstMoveCutoffRate\": " << run.ordering.firstMoveCutoffRate()
+             << ", \"cutoffsByStage\": {";
+        for (int stage = 0; stage < PICK_STAGE_COUNT; ++stage) {
+            file << (stage ? ", " : "") << jsonString(pickStageName(static_cast<PickStage>(stage))) << ": "
+                 << run.ordering.cutoffsByStage[stage];
         }
-    } else {
-        std::cout << "PROBLEM: Brak ruchów dla czarnych - plansza nie została zainicjalizowana!" << std::endl;
+        file << "}"
+             << ", \"bestMove\": " << jsonString(run.iterations.empty() ? "" : formatMove(run.iterations.back().bestMove))
+             << ", \"iterations\": [";
+        for (size_t d = 0; d < run.iterations.size(); ++d) {
+            const SearchIteration& iteration = run.iterations[d];
+            file << (d ? ", " : "") << "{\"depth\": " << iteration.depth << ", \"timeMs\": " << iteration.elapsedMs
+                 << ", \"nodes\": " << iteration.nodes << ", \"score\": " << iteration.score << "}";
+        }
+        file << "]}";
     }
+    file << "\n  ]\n}\n";
+    return file.good();
 }
-void testSpecificPosition() {
-    std::cout << "=== TEST KONKRETNEJ POZYCJI ===" << std::endl;
-    
-    Board testBoard;
-    testBoard.initialize();
-    
-    PerformanceMeasurer measurer;
-    
-    for (int depth = 1; depth <= 5; ++depth) {
-        double time = measurer.measureSingleMove(testBoard, depth);
-        std::cout << "Głębokość " << depth << ": " << std::fixed << std::setprecision(2) 
-                 << time << " ms" << std::endl;
+
+bool writeCsv(const std::string& path, const std::vector<BenchmarkRun>& runs) {
+    std::ofstream file(path);
+    if (!file.is_open()) return false;
+
+    file << "position,category,threads,rep,depth,time_ms,nodes,nps,ebf,best_move,beta_cutoffs,first_move_cutoff_rate";
+    for (int stage = 0; stage < PICK_STAGE_COUNT; ++stage) file << ",cutoffs_" << pickStageName(static_cast<PickStage>(stage));
+    file << '\n';
+    file << std::fixed << std::setprecision(3);
+    for (const BenchmarkRun& run : runs) {
+        file << run.position->name << ',' << run.position->category << ',' << run.threads << ',' << run.rep << ','
+             << run.depth() << ',' << run.timeMs << ',' << run.nodes() << ',' << run.nps() << ','
+             << run.branchingFactor() << ','
+             << (run.iterations.empty() ? "" : formatMove(run.iterations.back().bestMove)) << ','
+             << run.ordering.betaCutoffs << ',' << run.ordering.firstMoveCutoffRate();
+        for (uint64_t count : run.ordering.cutoffsByStage) file << ',' << count;
+        file << '\n';
     }
+    return file.good();
 }
 
-int main() {
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cout << "Użycie: " << argv[0] << " [--depth N] [--time MS] [--threads N] [--mode lazy|root|ybwc] [--qply N]"
+                  << " [--reps N] [--category C] [--scaling] [--json PLIK] [--csv PLIK] [--trace PLIK]" << std::endl;
+        return 1;
+    }
+
+    std::vector<const BenchmarkPosition*> positions;
+    for (const BenchmarkPosition& position : CORPUS) {
+        Bitboard board;
+        if (!parsePosition(position.position, board)) {
+            std::cerr << "Błędny zapis pozycji " << position.name << std::endl;
+            return 1;
+        }
+        if (options.category.empty() || options.category == position.category) positions.push_back(&position);
+    }
+    if (positions.empty()) {
+        std::cerr << "Brak pozycji w kategorii " << options.category << std::endl;
+        return 1;
+    }
+
+    // 1, 2, 4, ... i na koniec wszystkie wątki (przy --scaling), inaczej tylko --threads
+    std::vector<int> threadCounts;
+    if (options.scaling) {
+        for (int threads = 1; threads < options.threads; threads *= 2) threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(options.threads);
+
+    if (!options.tracePath.empty()) {
+        enableTrace(true);
+        setTraceThreadName("główny");
+    }
+
+    std::vector<BenchmarkRun> runs;
     try {
-        debugBoardState();
-        
-        std::cout << "\nCzy chcesz kontynuować pełne testy? (t/n): ";
-        char choice;
-        std::cin >> choice;
-        
-        if (choice == 't' || choice == 'T') {
-            PerformanceMeasurer measurer;
-            measurer.runFullPerformanceTest();
+        for (int threads : threadCounts) {
+            for (const BenchmarkPosition* position : positions) {
+                for (int rep = 0; rep < options.reps; ++rep) runs.push_back(runSearch(*position, options, threads, rep));
+            }
+            printRunTable(runs, threads, options);
         }
-        
     } catch (const std::exception& e) {
-        std::cout << "Błąd: " << e.what() << std::endl;
+        std::cerr << "Błąd: " << e.what() << std::endl;
+        return 1;
+    }
+
+    if (threadCounts.size() > 1) {
+        std::cout << "Przyspieszenie (" << modeName(options.mode) << "):";
+        for (int threads : threadCounts) {
+            std::cout << " " << threads << ":" << std::setprecision(2)
+                      << totalTime(runs, 1) / std::max(totalTime(runs, threads), 1e-3) << "x";
+        }
+        std::cout << std::endl;
+    }
+
+    if (!options.jsonPath.empty() && !writeJson(options.jsonPath, runs, options)) {
+        std::cerr << "Nie udało się zapisać " << options.jsonPath << std::endl;
+        return 1;
+    }
+    if (!options.csvPath.empty() && !writeCsv(options.csvPath, runs)) {
+        std::cerr << "Nie udało się zapisać " << options.csvPath << std::endl;
+        return 1;
+    }
+    if (!options.tracePath.empty() && !writeTrace(options.tracePath)) {
+        std::cerr << "Nie udało się zapisać " << options.tracePath << std::endl;
         return 1;
     }
-    
     return 0;
-}
\ No newline at end of file
+}
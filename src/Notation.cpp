@@ -0,0 +1,88 @@
+#include "../include/Notation.hpp"
+#include <cctype>
+#include <sstream>
+
+namespace {
+
+// "K12", "5-8" albo "17" (bez spacji); false przy błędnym numerze
+bool parseSquares(const std::string& item, uint32_t& squares, bool& isKing) {
+    std::string text = item;
+    isKing = !text.empty() && text[0] == 'K';
+    if (isKing) text.erase(0, 1);
+
+    size_t dash = text.find('-');
+    std::string firstText = text.substr(0, dash);
+    std::string lastText = (dash == std::string::npos) ? firstText : text.substr(dash + 1);
+    for (const std::string& number : {firstText, lastText}) {
+        if (number.empty() || number.size() > 2) return false;
+        for (char c : number) {
+            if (!std::isdigit(static_cast<unsigned char>(c))) return false;
+        }
+    }
+
+    int first = std::stoi(firstText);
+    int last = std::stoi(lastText);
+    if (first < 1 || last > 32 || first > last) return false;
+    squares = 0;
+    for (int number = first; number <= last; ++number) squares |= squareBit(number - 1);
+    return true;
+}
+
+void appendSquares(std::ostringstream& out, uint32_t pieces, uint32_t kings) {
+    bool first = true;
+    for (; pieces; pieces &= pieces - 1) {
+        int sq = lowestSquare(pieces);
+        if (!first) out << ',';
+        if (kings & squareBit(sq)) out << 'K';
+        out << sq + 1;
+        first = false;
+    }
+}
+
+const uint32_t ROW_0 = 0x0000000Fu;
+const uint32_t ROW_7 = 0xF0000000u;
+
+} // namespace
+
+bool parsePosition(const std::string& text, Bitboard& board) {
+    std::istringstream in(text);
+    std::string part;
+    if (!std::getline(in, part, ':') || part.size() != 1 || (part[0] != 'W' && part[0] != 'B')) return false;
+    Piececolor toMove = (part[0] == 'W') ? Piececolor::White : Piececolor::Black;
+
+    uint32_t white = 0, black = 0, kings = 0;
+    while (std::getline(in, part, ':')) {
+        if (part.empty() || (part[0] != 'W' && part[0] != 'B')) return false;
+        uint32_t& pieces = (part[0] == 'W') ? white : black;
+
+        std::istringstream items(part.substr(1));
+        std::string item;
+        while (std::getline(items, item, ',')) {
+            if (item.empty()) continue;
+            uint32_t squares;
+            bool isKing;
+            if (!parseSquares(item, squares, isKing) || ((white | black) & squares)) return false;
+            pieces |= squares;
+            if (isKing) kings |= squares;
+        }
+    }
+
+    // pionek w rzędzie promocji byłby już damką
+    if ((white & ~kings & ROW_0) || (black & ~kings & ROW_7)) return false;
+    board.setPosition(white, black, kings, toMove);
+    return true;
+}
+
+std::string formatPosition(const Bitboard& board) {
+    std::ostringstream out;
+    out << (board.getCurrentPlayer() == Piececolor::White ? 'W' : 'B') << ":W";
+    appendSquares(out, board.getPieces(Piececolor::White), board.getKings());
+    out << ":B";
+    appendSquares(out, board.getPieces(Piececolor::Black), board.getKings());
+    return out.str();
+}
+
+std::string formatMove(const Move& move) {
+    return std::to_string(move.getFromSquare() + 1) + (move.isCapture() ? "x" : "-") +
+           std::to_string(move.getToSquare() + 1);
+}
@@ -0,0 +1,97 @@
+#include "../include/OpeningBook.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+const char BOOK_MAGIC[4] = {'C', 'K', 'O', 'B'};
+const uint32_t BOOK_VERSION = 1;
+
+struct OpeningBookHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t entries;
+};
+
+bool keyLess(const OpeningBookEntry& a, const OpeningBookEntry& b) {
+    return a.key < b.key;
+}
+
+} // namespace
+
+bool writeOpeningBook(const std::string& path, std::vector<OpeningBookEntry> entries) {
+    std::stable_sort(entries.begin(), entries.end(), keyLess);
+
+    OpeningBookHeader header;
+    std::memcpy(header.magic, BOOK_MAGIC, sizeof(BOOK_MAGIC));
+    header.version = BOOK_VERSION;
+    header.entries = entries.size();
+
+    // najpierw plik tymczasowy - przerwany zapis nie zostawi uszkodzonej książki
+    std::string tmpPath = path + ".tmp";
+    FILE* file = std::fopen(tmpPath.c_str(), "wb");
+    if (!file) return false;
+
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+              std::fwrite(entries.data(), sizeof(OpeningBookEntry), entries.size(), file) == entries.size();
+    ok = (std::fclose(file) == 0) && ok;
+    if (!ok) {
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    std::remove(path.c_str());
+    return std::rename(tmpPath.c_str(), path.c_str()) == 0;
+}
+
+bool OpeningBook::open(const std::string& path) {
+    entries.clear();
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return false;
+
+    OpeningBookHeader header;
+    std::vector<OpeningBookEntry> loaded;
+    bool ok = std::fread(&header, sizeof(header), 1, file) == 1 &&
+              std::memcmp(header.magic, BOOK_MAGIC, sizeof(BOOK_MAGIC)) == 0 &&
+              header.version == BOOK_VERSION;
+    if (ok) {
+        loaded.resize(header.entries);
+        ok = std::fread(loaded.data(), sizeof(OpeningBookEntry), loaded.size(), file) == loaded.size() &&
+             std::is_sorted(loaded.begin(), loaded.end(), keyLess);
+    }
+    std::fclose(file);
+    if (ok) entries = std::move(loaded);
+    return ok;
+}
+
+bool OpeningBook::probe(const Bitboard& board, Move& move) {
+    if (entries.empty() || board.getCurrentPlayer() != Piececolor::Black) return false;
+
+    OpeningBookEntry probeKey{board.getHash(), 0, 0, 0, 0};
+    auto range = std::equal_range(entries.begin(), entries.end(), probeKey, keyLess);
+
+    // tylko ruchy, które są w tej pozycji legalne (chroni przed kolizją kluczy)
+    MoveList legal = board.getAllValidMoves(Piececolor::Black);
+    MoveList candidates;
+    std::vector<uint32_t> weights;
+    for (auto entry = range.first; entry != range.second; ++entry) {
+        for (const Move& candidate : legal) {
+            if (candidate.getFromSquare() == entry->fromSquare && candidate.getToSquare() == entry->toSquare) {
+                candidates.push_back(candidate);
+                weights.push_back(std::max<uint32_t>(entry->weight, 1));
+                break;
+            }
+        }
+    }
+    if (candidates.empty()) return false;
+
+    std::discrete_distribution<int> pick(weights.begin(), weights.end());
+    std::lock_guard<std::mutex> lock(randomMutex);
+    move = candidates[pick(random)];
+    return true;
+}
+
+OpeningBook& openingBook() {
+    static OpeningBook book;
+    return book;
+}
@@ -0,0 +1,135 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include "../include/AI.hpp"
+#include "../include/OpeningBook.hpp"
+
+/*
+Generator książki debiutowej - silnik gra sam ze sobą od pozycji początkowej.
+Użycie: OpeningBookGen <plik> [ply=10] [głębokość=8] [wątki]
+
+Białe (człowiek) mogą zagrać cokolwiek, więc po ich stronie rozwijane są wszystkie ruchy. Po stronie
+czarnych każdy ruch jest oceniany przeszukiwaniem na stałej głębokości; do książki trafiają ruchy
+nie gorsze od najlepszego o więcej niż BOOK_MARGIN (najwyżej BOOK_MAX_MOVES) i tylko one są rozwijane dalej.
+Waga ruchu maleje z odległością od najlepszego wyniku - probe losuje proporcjonalnie do wag.
+*/
+
+namespace {
+
+const int BOOK_MARGIN = 10;
+const int BOOK_MAX_MOVES = 3;
+
+struct ScoredMove {
+    Move move;
+    int score;
+};
+
+// oceny wszystkich ruchów czarnych: każdy w pełnym oknie, żeby dało się je porównać
+std::vector<ScoredMove> scoreMoves(const Bitboard& position, int depth, TranspositionTable& tt) {
+    Bitboard board = position;
+    MoveList moves = board.getAllValidMoves(Piececolor::Black);
+    SearchContext ctx(tt);
+
+    std::vector<ScoredMove> scored;
+    for (const Move& move : moves) {
+        UndoInfo undo = board.applyMove(move);
+        int score = minimax(board, depth - 1, 1, -100000, 100000, false, ctx);
+        board.undoMove(move, undo);
+        scored.push_back({move, score});
+    }
+    std::stable_sort(scored.begin(), scored.end(),
+                     [](const ScoredMove& a, const ScoredMove& b) { return a.score > b.score; });
+    return scored;
+}
+
+// ruchy do książki: najlepszy i te, które niewiele mu ustępują
+std::vector<ScoredMove> bookMoves(const std::vector<ScoredMove>& scored) {
+    std::vector<ScoredMove> kept;
+    for (const ScoredMove& candidate : scored) {
+        if (kept.size() == BOOK_MAX_MOVES || candidate.score < scored.front().score - BOOK_MARGIN) break;
+        kept.push_back(candidate);
+    }
+    return kept;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cout << "Użycie: " << argv[0] << " <plik> [ply=10] [głębokość=8] [wątki]" << std::endl;
+        return 1;
+    }
+    std::string path = argv[1];
+    int plies = (argc > 2) ? std::max(1, std::atoi(argv[2])) : 10;
+    int depth = (argc > 3) ? std::clamp(std::atoi(argv[3]), 1, MAX_SEARCH_DEPTH) : 8;
+    int threads = (argc > 4) ? std::max(1, std::atoi(argv[4])) : defaultSearchThreads();
+
+    TranspositionTable& tt = aiTranspositionTable();
+    ThreadPool pool(threads);
+    std::vector<OpeningBookEntry> entries;
+    std::mutex entriesMutex;
+
+    Bitboard start;
+    start.initialize();
+    std::vector<Bitboard> frontier{start};
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (int ply = 0; ply < plies && !frontier.empty(); ++ply) {
+        std::vector<std::vector<Bitboard>> children(frontier.size());
+
+        for (size_t i = 0; i < frontier.size(); ++i) {
+            pool.submit([&, i](int) {
+                const Bitboard& position = frontier[i];
+                Piececolor player = position.getCurrentPlayer();
+                MoveList moves = position.getAllValidMoves(player);
+
+                // jedyny ruch AI wykonuje bez przeszukiwania, więc nie potrzebuje wpisu
+                std::vector<Move> followed(moves.begin(), moves.end());
+                if (player == Piececolor::Black && moves.size() > 1) {
+                    std::vector<ScoredMove> kept = bookMoves(scoreMoves(position, depth, tt));
+                    followed.clear();
+                    std::lock_guard<std::mutex> lock(entriesMutex);
+                    for (const ScoredMove& candidate : kept) {
+                        int weight = 1 + BOOK_MARGIN - (kept.front().score - candidate.score);
+                        entries.push_back({position.getHash(), static_cast<uint8_t>(candidate.move.getFromSquare()),
+                                           static_cast<uint8_t>(candidate.move.getToSquare()),
+                                           static_cast<uint16_t>(weight), 0});
+                        followed.push_back(candidate.move);
+                    }
+                }
+                for (const Move& move : followed) {
+                    Bitboard child = position;
+                    child.applyMove(move);
+                    children[i].push_back(child);
+                }
+            });
+        }
+        pool.wait();
+
+        // pozycje osiągalne różnymi drogami rozwijane raz
+        std::unordered_set<uint64_t> seen;
+        std::vector<Bitboard> next;
+        for (const auto& list : children) {
+            for (const Bitboard& child : list) {
+                if (seen.insert(child.getHash()).second) next.push_back(child);
+            }
+        }
+        frontier = std::move(next);
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - startTime);
+        std::cout << "ply " << ply + 1 << ": " << entries.size() << " wpisów, " << frontier.size()
+                  << " pozycji do rozwinięcia (" << elapsed.count() << " s)" << std::endl;
+    }
+
+    if (!writeOpeningBook(path, entries)) {
+        std::cerr << "Nie udało się zapisać " << path << std::endl;
+        return 1;
+    }
+    std::cout << "Zapisano " << entries.size() << " wpisów do " << path << std::endl;
+    return 0;
+}
@@ -0,0 +1,154 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "../include/Bitboard.hpp"
+#include "../include/Notation.hpp"
+
+/*
+Perft - liczba liści drzewa ruchów do danej głębokości; sprawdza generator ruchów i mierzy jego szybkość.
+Użycie:
+    Perft                                  - pozycje wzorcowe, porównanie z zapisanymi wynikami
+    Perft <głębokość> [pozycja] [divide]   - jedna pozycja (domyślnie początkowa), divide: wynik dla każdego ruchu
+Pozycja w zapisie z Notation.hpp, np. "W:W21-32:B1-12".
+*/
+
+namespace {
+
+struct PerftCounts {
+    uint64_t nodes = 0;
+    uint64_t captures = 0;  // liście, do których prowadzi bicie
+
+    PerftCounts& operator+=(const PerftCounts& other) {
+        nodes += other.nodes;
+        captures += other.captures;
+        return *this;
+    }
+};
+
+// na ostatnim poziomie liście są liczone bez wykonywania ruchów (bicie jest obowiązkowe,
+// więc albo wszystkie ruchy są biciami, albo żaden)
+PerftCounts perft(Bitboard& board, int depth) {
+    PerftCounts counts;
+    MoveList moves = board.getAllValidMoves(board.getCurrentPlayer());
+    if (depth == 1) {
+        counts.nodes = moves.size();
+        counts.captures = (!moves.empty() && moves.front().isCapture()) ? moves.size() : 0;
+        return counts;
+    }
+    for (const Move& move : moves) {
+        UndoInfo undo = board.applyMove(move);
+        counts += perft(board, depth - 1);
+        board.undoMove(move, undo);
+    }
+    return counts;
+}
+
+// wyniki sprawdzone niezależną (wolną) implementacją zasad
+struct PerftReference {
+    const char* name;
+    const char* position;
+    int depth;
+    uint64_t nodes;
+    uint64_t captures;
+};
+
+const PerftReference REFERENCES[] = {
+    {"początkowa",  "W:W21-32:B1-12", 8, 844361, 113760},
+    {"środek gry",  "W:W18,19,21,23,24,26,27,28,29,30,32:B1,2,3,5,6,7,9,10,12,13", 9, 889164, 170858},
+    {"bicia",       "B:W14,15,18,19,22,23,26,27:B5,6,7,9,10,11", 9, 51745, 5671},
+    {"damki",       "B:WK3,K14,22,25,K29:BK7,11,K18,K27,5", 8, 1544822, 189160},
+    {"końcówka",    "W:WK10,K31:BK1,K23,15", 8, 10726535, 787417},
+};
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void printCounts(const PerftCounts& counts, double seconds) {
+    std::cout << "liście: " << counts.nodes << ", bicia: " << counts.captures << ", czas: "
+              << std::fixed << std::setprecision(3) << seconds << " s, "
+              << std::setprecision(0) << counts.nodes / std::max(seconds, 1e-9) << " liści/s" << std::endl;
+}
+
+int runReferences() {
+    int failures = 0;
+    uint64_t totalNodes = 0;
+    double totalSeconds = 0;
+    for (const PerftReference& reference : REFERENCES) {
+        Bitboard board;
+        if (!parsePosition(reference.position, board)) {
+            std::cout << reference.name << ": błędny zapis pozycji" << std::endl;
+            failures++;
+            continue;
+        }
+        auto start = std::chrono::steady_clock::now();
+        PerftCounts counts = perft(board, reference.depth);
+        double seconds = secondsSince(start);
+        totalNodes += counts.nodes;
+        totalSeconds += seconds;
+
+        bool ok = counts.nodes == reference.nodes && counts.captures == reference.captures;
+        if (!ok) failures++;
+        std::cout << (ok ? "OK   " : "BŁĄD ") << reference.name << ", głębokość " << reference.depth << ": ";
+        printCounts(counts, seconds);
+        if (!ok) {
+            std::cout << "     oczekiwano liści: " << reference.nodes << ", bicia: " << reference.captures << std::endl;
+        }
+    }
+    std::cout << "Razem: " << totalNodes << " liści, "
+              << std::setprecision(0) << totalNodes / std::max(totalSeconds, 1e-9) << " liści/s, "
+              << failures << " błędów" << std::endl;
+    return failures ? 1 : 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) return runReferences();
+
+    int depth = std::atoi(argv[1]);
+    if (depth < 1) {
+        std::cout << "Użycie: " << argv[0] << " [<głębokość> [pozycja] [divide]]" << std::endl;
+        return 1;
+    }
+    bool divide = false;
+    std::string position = "W:W21-32:B1-12";
+    for (int i = 2; i < argc; ++i) {
+        if (std::strcmp(argv[i], "divide") == 0) divide = true;
+        else position = argv[i];
+    }
+
+    Bitboard board;
+    if (!parsePosition(position, board)) {
+        std::cout << "Błędny zapis pozycji: " << position << std::endl;
+        return 1;
+    }
+    std::cout << formatPosition(board) << std::endl;
+
+    auto start = std::chrono::steady_clock::now();
+    PerftCounts total;
+    if (divide) {
+        MoveList moves = board.getAllValidMoves(board.getCurrentPlayer());
+        for (const Move& move : moves) {
+            PerftCounts counts;
+            if (depth == 1) {
+                counts.nodes = 1;
+                counts.captures = move.isCapture() ? 1 : 0;
+            } else {
+                UndoInfo undo = board.applyMove(move);
+                counts = perft(board, depth - 1);
+                board.undoMove(move, undo);
+            }
+            std::cout << std::setw(6) << formatMove(move) << ": " << counts.nodes << std::endl;
+            total += counts;
+        }
+    } else {
+        total = perft(board, depth);
+    }
+    printCounts(total, secondsSince(start));
+    return 0;
+}
@@ -1,4 +1,4 @@
-#include "C:\Visual Studio\PiAA_proj3\include\Piece.hpp"
+#include "../include/Piece.hpp"
 
 Piece::Piece(Piececolor color, Piecetype type) : color(color), type(type) {}
 
@@ -0,0 +1,415 @@
+#include "../include/Tablebase.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+// współczynniki dwumianowe C(n, k) dla n <= 32, k <= TB_MAX_PIECES
+struct Binomials {
+    uint64_t value[33][TB_MAX_PIECES + 1];
+};
+
+constexpr Binomials makeBinomials() {
+    Binomials t{};
+    for (int n = 0; n <= 32; ++n) {
+        t.value[n][0] = 1;
+        for (int k = 1; k <= TB_MAX_PIECES; ++k) {
+            t.value[n][k] = (n == 0) ? 0 : t.value[n - 1][k - 1] + t.value[n - 1][k];
+        }
+    }
+    return t;
+}
+
+constexpr Binomials BINOMIALS = makeBinomials();
+
+inline uint64_t binomial(int n, int k) {
+    return (k < 0 || k > TB_MAX_PIECES || n < 0) ? 0 : BINOMIALS.value[n][k];
+}
+
+const int MEN_SQUARES = 28;
+const int KING_SQUARES = 32;
+const int THEIR_MEN_OFFSET = 4; // ich pionki nie stoją w rzędzie 0
+
+// numer zestawu pól (colex): suma C(pole_i, i + 1) po polach rosnąco
+uint64_t rankSquares(uint32_t mask, int offset) {
+    uint64_t rank = 0;
+    int i = 0;
+    for (; mask; mask &= mask - 1) {
+        rank += binomial(lowestSquare(mask) - offset, ++i);
+    }
+    return rank;
+}
+
+uint32_t unrankSquares(uint64_t rank, int count, int offset, int squares) {
+    uint32_t mask = 0;
+    int p = squares - 1;
+    for (int i = count; i >= 1; --i) {
+        while (binomial(p, i) > rank) --p;
+        rank -= binomial(p, i);
+        mask |= squareBit(p + offset);
+        --p;
+    }
+    return mask;
+}
+
+uint32_t rotateSquares(uint32_t mask) {
+    // obrót o 180 stopni: pole sq -> 31 - sq, czyli odwrócenie kolejności bitów
+    uint32_t rotated = 0;
+    for (; mask; mask &= mask - 1) rotated |= squareBit(31 - lowestSquare(mask));
+    return rotated;
+}
+
+const char TB_MAGIC[4] = {'C', 'K', 'T', 'B'};
+const uint32_t TB_VERSION = 2;
+
+struct TablebaseHeader {
+    char magic[4];
+    uint32_t version;
+    int32_t signature[4];
+    uint64_t entries;
+    uint32_t blockSize;
+    uint32_t blockCount;
+};
+
+/*
+PackBits: bajt sterujący n
+    0..127   - n + 1 bajtów przepisanych dosłownie
+    129..255 - następny bajt powtórzony 257 - n razy
+Seria musi mieć co najmniej 3 bajty, żeby się opłacała.
+*/
+const size_t MAX_PACKET = 128;
+
+size_t runLength(const uint8_t* in, size_t size, size_t at) {
+    size_t length = 1;
+    while (at + length < size && length < MAX_PACKET && in[at + length] == in[at]) ++length;
+    return length;
+}
+
+void packBits(const uint8_t* in, size_t size, std::vector<uint8_t>& out) {
+    size_t i = 0;
+    while (i < size) {
+        size_t run = runLength(in, size, i);
+        if (run >= 3) {
+            out.push_back(static_cast<uint8_t>(257 - run));
+            out.push_back(in[i]);
+            i += run;
+            continue;
+        }
+        size_t start = i;
+        while (i < size && i - start < MAX_PACKET && runLength(in, size, i) < 3) ++i;
+        out.push_back(static_cast<uint8_t>(i - start - 1));
+        out.insert(out.end(), in + start, in + i);
+    }
+}
+
+bool unpackBits(const uint8_t* in, size_t size, uint8_t* out, size_t outSize) {
+    size_t i = 0, o = 0;
+    while (i < size) {
+        uint8_t control = in[i++];
+        if (control < 128) {
+            size_t length = control + 1u;
+            if (i + length > size || o + length > outSize) return false;
+            std::memcpy(out + o, in + i, length);
+            i += length;
+            o += length;
+        } else if (control > 128) {
+            size_t length = 257u - control;
+            if (i >= size || o + length > outSize) return false;
+            std::memset(out + o, in[i++], length);
+            o += length;
+        }
+    }
+    return o == outSize;
+}
+
+uint64_t readOffset(const uint8_t* offsets, uint32_t i) {
+    uint64_t offset;
+    std::memcpy(&offset, offsets + i * sizeof(uint64_t), sizeof(offset));
+    return offset;
+}
+
+} // namespace
+
+MaterialSignature TablebasePosition::signature() const {
+    return {popCount(ourMen), popCount(ourKings), popCount(theirMen), popCount(theirKings)};
+}
+
+Bitboard TablebasePosition::toBitboard() const {
+    Bitboard board;
+    board.setPosition(theirMen | theirKings, ourMen | ourKings, ourKings | theirKings, Piececolor::Black);
+    return board;
+}
+
+uint64_t tablebaseSize(const MaterialSignature& s) {
+    return binomial(MEN_SQUARES, s.ourMen) * binomial(MEN_SQUARES, s.theirMen)
+         * binomial(KING_SQUARES, s.ourKings) * binomial(KING_SQUARES, s.theirKings);
+}
+
+uint64_t tablebaseIndex(const TablebasePosition& p) {
+    MaterialSignature s = p.signature();
+    uint64_t index = rankSquares(p.ourMen, 0);
+    index = index * binomial(MEN_SQUARES, s.theirMen) + rankSquares(p.theirMen, THEIR_MEN_OFFSET);
+    index = index * binomial(KING_SQUARES, s.ourKings) + rankSquares(p.ourKings, 0);
+    index = index * binomial(KING_SQUARES, s.theirKings) + rankSquares(p.theirKings, 0);
+    return index;
+}
+
+bool tablebasePosition(const MaterialSignature& s, uint64_t index, TablebasePosition& p) {
+    uint64_t theirKingsCount = binomial(KING_SQUARES, s.theirKings);
+    uint64_t ourKingsCount = binomial(KING_SQUARES, s.ourKings);
+    uint64_t theirMenCount = binomial(MEN_SQUARES, s.theirMen);
+
+    p.theirKings = unrankSquares(index % theirKingsCount, s.theirKings, 0, KING_SQUARES);
+    index /= theirKingsCount;
+    p.ourKings = unrankSquares(index % ourKingsCount, s.ourKings, 0, KING_SQUARES);
+    index /= ourKingsCount;
+    p.theirMen = unrankSquares(index % theirMenCount, s.theirMen, THEIR_MEN_OFFSET, MEN_SQUARES);
+    index /= theirMenCount;
+    p.ourMen = unrankSquares(index, s.ourMen, 0, MEN_SQUARES);
+
+    uint32_t groups[4] = {p.ourMen, p.theirMen, p.ourKings, p.theirKings};
+    uint32_t seen = 0;
+    for (uint32_t group : groups) {
+        if (seen & group) return false;
+        seen |= group;
+    }
+    return true;
+}
+
+TablebasePosition normalizePosition(const Bitboard& board, Piececolor toMove) {
+    uint32_t kings = board.getKings();
+    uint32_t our = board.getPieces(toMove);
+    uint32_t their = board.getPieces(opponent(toMove));
+
+    TablebasePosition p;
+    p.ourMen = our & ~kings;
+    p.ourKings = our & kings;
+    p.theirMen = their & ~kings;
+    p.theirKings = their & kings;
+    if (toMove == Piececolor::White) {
+        p.ourMen = rotateSquares(p.ourMen);
+        p.ourKings = rotateSquares(p.ourKings);
+        p.theirMen = rotateSquares(p.theirMen);
+        p.theirKings = rotateSquares(p.theirKings);
+    }
+    return p;
+}
+
+std::string tablebaseFileName(const std::string& directory, const MaterialSignature& s) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "tb_%d%d%d%d.bin", s.ourMen, s.ourKings, s.theirMen, s.theirKings);
+    return directory.empty() ? name : directory + "/" + name;
+}
+
+bool writeTablebaseFile(const std::string& path, const MaterialSignature& s, const std::vector<uint8_t>& values) {
+    TablebaseHeader header;
+    std::memcpy(header.magic, TB_MAGIC, sizeof(TB_MAGIC));
+    header.version = TB_VERSION;
+    header.signature[0] = s.ourMen;
+    header.signature[1] = s.ourKings;
+    header.signature[2] = s.theirMen;
+    header.signature[3] = s.theirKings;
+    header.entries = values.size();
+    header.blockSize = TB_BLOCK_SIZE;
+    header.blockCount = static_cast<uint32_t>((values.size() + TB_BLOCK_SIZE - 1) / TB_BLOCK_SIZE);
+
+    // przesunięcia liczone od początku obszaru bloków
+    std::vector<uint8_t> blocks;
+    std::vector<uint64_t> offsets;
+    for (uint64_t begin = 0; begin < values.size(); begin += TB_BLOCK_SIZE) {
+        offsets.push_back(blocks.size());
+        packBits(values.data() + begin, std::min<uint64_t>(TB_BLOCK_SIZE, values.size() - begin), blocks);
+    }
+    offsets.push_back(blocks.size());
+
+    // najpierw plik tymczasowy - przerwany zapis nie zostawi uszkodzonej bazy
+    std::string tmpPath = path + ".tmp";
+    FILE* file = std::fopen(tmpPath.c_str(), "wb");
+    if (!file) return false;
+
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+              std::fwrite(offsets.data(), sizeof(uint64_t), offsets.size(), file) == offsets.size() &&
+              std::fwrite(blocks.data(), 1, blocks.size(), file) == blocks.size();
+    ok = (std::fclose(file) == 0) && ok;
+    if (!ok) {
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    std::remove(path.c_str());
+    return std::rename(tmpPath.c_str(), path.c_str()) == 0;
+}
+
+bool readTablebaseFile(const std::string& path, const MaterialSignature& s, std::vector<uint8_t>& values) {
+    TablebaseSlice slice;
+    if (!slice.openFile(path, s)) return false;
+
+    values.resize(slice.entries);
+    std::vector<uint8_t> block;
+    for (uint32_t b = 0; b < slice.blockCount; ++b) {
+        if (!slice.readBlock(b, block)) return false;
+        std::copy(block.begin(), block.end(), values.begin() + static_cast<size_t>(b) * TB_BLOCK_SIZE);
+    }
+    return true;
+}
+
+bool TablebaseSlice::openFile(const std::string& path, const MaterialSignature& s) {
+    if (!file.open(path)) return false;
+
+    TablebaseHeader header;
+    if (file.getSize() < sizeof(header)) return false;
+    std::memcpy(&header, file.getData(), sizeof(header));
+    uint64_t expectedBlocks = (tablebaseSize(s) + TB_BLOCK_SIZE - 1) / TB_BLOCK_SIZE;
+    bool ok = std::memcmp(header.magic, TB_MAGIC, sizeof(TB_MAGIC)) == 0 &&
+              header.version == TB_VERSION &&
+              header.signature[0] == s.ourMen && header.signature[1] == s.ourKings &&
+              header.signature[2] == s.theirMen && header.signature[3] == s.theirKings &&
+              header.entries == tablebaseSize(s) &&
+              header.blockSize == TB_BLOCK_SIZE && header.blockCount == expectedBlocks;
+    if (!ok) return false;
+
+    // indeks bloków musi się mieścić w pliku, a ostatnie przesunięcie wskazywać jego koniec
+    uint64_t indexSize = (static_cast<uint64_t>(header.blockCount) + 1) * sizeof(uint64_t);
+    if (file.getSize() < sizeof(header) + indexSize) return false;
+    offsets = file.getData() + sizeof(header);
+    blocks = offsets + indexSize;
+    if (readOffset(offsets, header.blockCount) != file.getSize() - sizeof(header) - indexSize) return false;
+    for (uint32_t b = 0; b < header.blockCount; ++b) {
+        if (readOffset(offsets, b) > readOffset(offsets, b + 1)) return false;
+    }
+
+    key = s.key();
+    entries = header.entries;
+    blockCount = header.blockCount;
+    return true;
+}
+
+bool TablebaseSlice::readBlock(uint32_t block, std::vector<uint8_t>& out) const {
+    uint64_t begin = static_cast<uint64_t>(block) * TB_BLOCK_SIZE;
+    out.resize(static_cast<size_t>(std::min<uint64_t>(TB_BLOCK_SIZE, entries - begin)));
+    uint64_t from = readOffset(offsets, block);
+    uint64_t to = readOffset(offsets, block + 1);
+    return unpackBits(blocks + from, static_cast<size_t>(to - from), out.data(), out.size());
+}
+
+void TablebaseBlockCache::setCapacity(size_t megabytes) {
+    size_t total = std::max<size_t>(megabytes * 1024 * 1024 / TB_BLOCK_SIZE, SHARDS);
+    clear();
+    blocksPerShard = total / SHARDS;
+}
+
+void TablebaseBlockCache::clear() {
+    for (Shard& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.blocks.clear();
+        shard.index.clear();
+    }
+}
+
+uint8_t TablebaseBlockCache::value(const TablebaseSlice& slice, uint32_t block, uint32_t offset) {
+    uint64_t id = (static_cast<uint64_t>(slice.key) << 32) | block;
+    Shard& shard = shards[(id ^ (id >> 32) * 0x9E3779B1u) % SHARDS];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto found = shard.index.find(id);
+    if (found != shard.index.end()) {
+        hits.fetch_add(1, std::memory_order_relaxed);
+        shard.blocks.splice(shard.blocks.begin(), shard.blocks, found->second);
+        return found->second->second[offset];
+    }
+
+    misses.fetch_add(1, std::memory_order_relaxed);
+    std::vector<uint8_t> values;
+    if (shard.blocks.size() >= blocksPerShard) {
+        // najdawniej używany blok oddaje swój bufor
+        values = std::move(shard.blocks.back().second);
+        shard.index.erase(shard.blocks.back().first);
+        shard.blocks.pop_back();
+    }
+    if (!slice.readBlock(block, values)) return TB_INVALID;
+    shard.blocks.emplace_front(id, std::move(values));
+    shard.index[id] = shard.blocks.begin();
+    return shard.blocks.front().second[offset];
+}
+
+void EndgameTablebase::open(const std::string& dir, int pieces) {
+    std::lock_guard<std::mutex> lock(loadMutex);
+    directory = dir;
+    for (int i = 0; i < TB_SIGNATURE_COUNT; ++i) {
+        slices[i] = nullptr;
+        missing[i] = false;
+    }
+    storage.clear();
+    cache.clear();
+    maxPieces = std::min(pieces, TB_MAX_PIECES);
+}
+
+const TablebaseSlice* EndgameTablebase::slice(const MaterialSignature& signature) {
+    int key = signature.key();
+    const TablebaseSlice* loaded = slices[key].load(std::memory_order_acquire);
+    if (loaded || missing[key].load(std::memory_order_relaxed)) return loaded;
+
+    // pierwsze użycie tego składu - mapowanie pliku pod blokadą (dane wczytuje system przy sondach)
+    std::lock_guard<std::mutex> lock(loadMutex);
+    loaded = slices[key].load(std::memory_order_acquire);
+    if (loaded || missing[key]) return loaded;
+
+    auto mapped = std::make_unique<TablebaseSlice>();
+    if (!mapped->openFile(tablebaseFileName(directory, signature), signature)) {
+        missing[key] = true;
+        return nullptr;
+    }
+    loaded = mapped.get();
+    storage.push_back(std::move(mapped));
+    slices[key].store(loaded, std::memory_order_release);
+    return loaded;
+}
+
+void EndgameTablebase::install(const MaterialSignature& signature, std::vector<uint8_t> values) {
+    auto inMemory = std::make_unique<TablebaseSlice>();
+    inMemory->key = signature.key();
+    inMemory->entries = values.size();
+    inMemory->values = std::move(values);
+
+    std::lock_guard<std::mutex> lock(loadMutex);
+    storage.push_back(std::move(inMemory));
+    missing[signature.key()] = false;
+    slices[signature.key()].store(storage.back().get(), std::memory_order_release);
+}
+
+uint8_t EndgameTablebase::lookup(const TablebasePosition& position) {
+    const TablebaseSlice* s = slice(position.signature());
+    if (!s) return TB_INVALID;
+    uint64_t index = tablebaseIndex(position);
+    if (!s->values.empty()) return s->values[index];
+    return cache.value(*s, static_cast<uint32_t>(index / TB_BLOCK_SIZE), static_cast<uint32_t>(index % TB_BLOCK_SIZE));
+}
+
+bool EndgameTablebase::probe(const Bitboard& board, Piececolor toMove, TbProbe& result) {
+    if (popCount(board.getOccupied()) > getMaxPieces()) return false;
+
+    TablebasePosition position = normalizePosition(board, toMove);
+    MaterialSignature signature = position.signature();
+    if (signature.ourMen + signature.ourKings == 0) {
+        result.result = TbResult::Loss;
+        result.distance = 0;
+        return true;
+    }
+    if (signature.theirMen + signature.theirKings == 0) return false;
+
+    uint8_t value = lookup(position);
+    if (value == TB_INVALID) return false;
+    if (value == TB_DRAW) {
+        result.result = TbResult::Draw;
+        result.distance = 0;
+    } else {
+        result.result = tbIsWin(value) ? TbResult::Win : TbResult::Loss;
+        result.distance = tbDistance(value);
+    }
+    return true;
+}
+
+EndgameTablebase& endgameTablebase() {
+    static EndgameTablebase tablebase;
+    return tablebase;
+}
@@ -0,0 +1,248 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "../include/Tablebase.hpp"
+#include "../include/ThreadPool.hpp"
+
+/*
+Generator baz końcówek - analiza wsteczna dla wszystkich składów do N pionków.
+Użycie: TablebaseGen <katalog> <maks. pionków> [wątki]
+
+Składy są liczone od najmniejszej liczby pionków, a przy tej samej liczbie - od najmniejszej liczby
+zwykłych pionków: bicie zmniejsza liczbę pionków, a promocja zamienia pionek w damkę, więc każda
+pozycja potomna jest w składzie już policzonym albo w tej samej parze składów (nasz / zamieniony).
+Gotowe składy są zapisywane od razu, więc przerwane generowanie wznawia się od pierwszego brakującego.
+*/
+
+namespace {
+
+// para składów liczonych razem: ruch z jednego prowadzi do drugiego (albo do tego samego, gdy symetryczny)
+struct TablebaseUnit {
+    std::vector<MaterialSignature> signatures;
+    std::vector<std::vector<uint8_t>> values;
+
+    int find(const MaterialSignature& signature) const {
+        for (size_t i = 0; i < signatures.size(); ++i) {
+            if (signatures[i] == signature) return static_cast<int>(i);
+        }
+        return -1;
+    }
+};
+
+const uint64_t CHUNK_SIZE = 1 << 16;
+
+// zmiana wpisu ustalona w jednej rundzie (stosowana po rundzie, żeby wątki czytały stały stan)
+struct TablebaseUpdate {
+    int table;
+    uint64_t index;
+    uint8_t value;
+};
+
+// wpis potomka spoza pary (gotowa baza); potomek bez własnych pionków to przegrana od razu
+uint8_t externalValue(const TablebasePosition& position, EndgameTablebase& tablebase) {
+    MaterialSignature signature = position.signature();
+    if (signature.ourMen + signature.ourKings == 0) return tbEncodeDistance(0);
+
+    uint8_t value = tablebase.lookup(position);
+    if (value == TB_INVALID) {
+        std::cerr << "Brak bazy dla " << tablebaseFileName("", signature) << std::endl;
+        std::exit(1);
+    }
+    return value;
+}
+
+// wpis pozycji potomnej od strony gracza, który jest w niej na ruchu (białe przed normalizacją)
+uint8_t childValue(const Bitboard& child, const TablebaseUnit& unit, EndgameTablebase& tablebase) {
+    TablebasePosition position = normalizePosition(child, Piececolor::White);
+    int table = unit.find(position.signature());
+    return (table >= 0) ? unit.values[table][tablebaseIndex(position)] : externalValue(position, tablebase);
+}
+
+// Wartość pozycji w rundzie round (wpisy z poprzednich rund mają odległość <= round - 1):
+// wygrana, gdy jakiś ruch prowadzi do przegranej przeciwnika; przegrana, gdy wszystkie do jego wygranej.
+uint8_t resolve(const Bitboard& board, const MoveList& moves, const TablebaseUnit& unit,
+                EndgameTablebase& tablebase, int round) {
+    bool allWins = true;
+    for (const Move& move : moves) {
+        Bitboard child = board;
+        child.applyMove(move);
+        uint8_t value = childValue(child, unit, tablebase);
+
+        bool known = value != TB_DRAW && tbDistance(value) <= round - 1;
+        if (known && tbIsLoss(value)) return tbEncodeDistance(round);
+        if (!known || !tbIsWin(value)) allWins = false;
+    }
+    return allWins ? tbEncodeDistance(round) : TB_DRAW;
+}
+
+void generateUnit(TablebaseUnit& unit, EndgameTablebase& tablebase, ThreadPool& pool) {
+    auto start = std::chrono::steady_clock::now();
+    for (const MaterialSignature& signature : unit.signatures) {
+        unit.values.emplace_back(tablebaseSize(signature), TB_DRAW);
+    }
+
+    // runda 0: pozycje niemożliwe i przegrane bez ruchu; przy okazji największa odległość w gotowych bazach,
+    // do których prowadzą ruchy (dopóki runda jej nie przekroczy, brak zmian nie kończy liczenia)
+    std::atomic<int> maxCrossDistance{0};
+    for (size_t t = 0; t < unit.signatures.size(); ++t) {
+        uint64_t size = unit.values[t].size();
+        for (uint64_t chunk = 0; chunk < size; chunk += CHUNK_SIZE) {
+            pool.submit([&, t, chunk, size](int) {
+                int localMax = 0;
+                for (uint64_t index = chunk; index < std::min(size, chunk + CHUNK_SIZE); ++index) {
+                    TablebasePosition position;
+                    if (!tablebasePosition(unit.signatures[t], index, position)) {
+                        unit.values[t][index] = TB_INVALID;
+                        continue;
+                    }
+                    Bitboard board = position.toBitboard();
+                    MoveList moves = board.getAllValidMoves(Piececolor::Black);
+                    if (moves.empty()) {
+                        unit.values[t][index] = tbEncodeDistance(0);
+                        continue;
+                    }
+                    for (const Move& move : moves) {
+                        Bitboard child = board;
+                        child.applyMove(move);
+                        TablebasePosition childPosition = normalizePosition(child, Piececolor::White);
+                        if (unit.find(childPosition.signature()) >= 0) continue;
+                        uint8_t value = externalValue(childPosition, tablebase);
+                        if (value != TB_DRAW) localMax = std::max(localMax, tbDistance(value));
+                    }
+                }
+                int current = maxCrossDistance.load();
+                while (localMax > current && !maxCrossDistance.compare_exchange_weak(current, localMax)) {}
+            });
+        }
+    }
+    pool.wait();
+
+    for (int round = 1; ; ++round) {
+        if (round > TB_MAX_DISTANCE) {
+            std::cerr << "Odległość przekracza format bazy" << std::endl;
+            std::exit(1);
+        }
+
+        std::vector<std::vector<TablebaseUpdate>> updates;
+        for (size_t t = 0; t < unit.signatures.size(); ++t) {
+            for (uint64_t chunk = 0; chunk < unit.values[t].size(); chunk += CHUNK_SIZE) updates.emplace_back();
+        }
+
+        size_t task = 0;
+        for (size_t t = 0; t < unit.signatures.size(); ++t) {
+            uint64_t size = unit.values[t].size();
+            for (uint64_t chunk = 0; chunk < size; chunk += CHUNK_SIZE, ++task) {
+                pool.submit([&, t, chunk, size, task, round](int) {
+                    for (uint64_t index = chunk; index < std::min(size, chunk + CHUNK_SIZE); ++index) {
+                        if (unit.values[t][index] != TB_DRAW) continue;
+                        TablebasePosition position;
+                        tablebasePosition(unit.signatures[t], index, position);
+                        Bitboard board = position.toBitboard();
+                        MoveList moves = board.getAllValidMoves(Piececolor::Black);
+                        uint8_t value = resolve(board, moves, unit, tablebase, round);
+                        if (value != TB_DRAW) updates[task].push_back({static_cast<int>(t), index, value});
+                    }
+                });
+            }
+        }
+        pool.wait();
+
+        size_t changed = 0;
+        for (const auto& list : updates) {
+            for (const TablebaseUpdate& update : list) unit.values[update.table][update.index] = update.value;
+            changed += list.size();
+        }
+        if (changed == 0 && round > maxCrossDistance) break;
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    for (size_t t = 0; t < unit.signatures.size(); ++t) {
+        uint64_t wins = 0, losses = 0, draws = 0;
+        for (uint8_t value : unit.values[t]) {
+            if (value == TB_DRAW) draws++;
+            else if (tbIsWin(value)) wins++;
+            else if (tbIsLoss(value)) losses++;
+        }
+        std::cout << "  " << tablebaseFileName("", unit.signatures[t]) << ": " << wins << " wygranych, "
+                  << losses << " przegranych, " << draws << " remisów" << std::endl;
+    }
+    std::cout << "  czas: " << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+              << " ms" << std::endl;
+}
+
+// wszystkie pary składów z total pionkami, w kolejności liczenia
+std::vector<TablebaseUnit> unitsWithPieces(int total) {
+    std::vector<TablebaseUnit> units;
+    for (int men = 0; men <= total; ++men) {
+        for (int ourMen = 0; ourMen <= men; ++ourMen) {
+            int theirMen = men - ourMen;
+            for (int ourKings = 0; ourKings <= total - men; ++ourKings) {
+                MaterialSignature signature{ourMen, ourKings, theirMen, total - men - ourKings};
+                if (signature.ourMen + signature.ourKings == 0 || signature.theirMen + signature.theirKings == 0) continue;
+                if (signature.swapped().key() < signature.key()) continue;
+
+                TablebaseUnit unit;
+                unit.signatures.push_back(signature);
+                if (!(signature.swapped() == signature)) unit.signatures.push_back(signature.swapped());
+                units.push_back(std::move(unit));
+            }
+        }
+    }
+    return units;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cout << "Użycie: " << argv[0] << " <katalog> <maks. pionków> [wątki]" << std::endl;
+        return 1;
+    }
+    std::string directory = argv[1];
+    int maxPieces = std::clamp(std::atoi(argv[2]), 2, TB_MAX_PIECES);
+    int threads = (argc > 3) ? std::max(1, std::atoi(argv[3])) : 0;
+    if (threads == 0) threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+    EndgameTablebase& tablebase = endgameTablebase();
+    tablebase.open(directory, maxPieces);
+    ThreadPool pool(threads);
+
+    for (int total = 2; total <= maxPieces; ++total) {
+        for (TablebaseUnit& unit : unitsWithPieces(total)) {
+            // już policzone (wznowienie) - wszystkie pliki pary dają się wczytać; trzymamy je rozpakowane,
+            // bo kolejne składy sięgają do nich przy każdym ruchu, a pamięć podręczna bloków by nie nadążała
+            bool done = true;
+            for (const MaterialSignature& signature : unit.signatures) {
+                std::vector<uint8_t> values;
+                if (!readTablebaseFile(tablebaseFileName(directory, signature), signature, values)) {
+                    done = false;
+                    break;
+                }
+                unit.values.push_back(std::move(values));
+            }
+            if (done) {
+                for (size_t t = 0; t < unit.signatures.size(); ++t) {
+                    tablebase.install(unit.signatures[t], std::move(unit.values[t]));
+                }
+                continue;
+            }
+            unit.values.clear();
+
+            std::cout << "Skład " << tablebaseFileName("", unit.signatures[0]) << "..." << std::endl;
+            generateUnit(unit, tablebase, pool);
+            for (size_t t = 0; t < unit.signatures.size(); ++t) {
+                if (!writeTablebaseFile(tablebaseFileName(directory, unit.signatures[t]), unit.signatures[t], unit.values[t])) {
+                    std::cerr << "Nie udało się zapisać " << tablebaseFileName(directory, unit.signatures[t]) << std::endl;
+                    return 1;
+                }
+                tablebase.install(unit.signatures[t], std::move(unit.values[t]));
+            }
+        }
+    }
+    std::cout << "Gotowe." << std::endl;
+    return 0;
+}
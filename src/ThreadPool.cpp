@@ -0,0 +1,88 @@
+#include "../include/ThreadPool.hpp"
+#include "../include/Trace.hpp"
+
+ThreadPool::ThreadPool(int threadCount) {
+    if (threadCount < 1) threadCount = 1;
+    for (int i = 0; i < threadCount; ++i) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+    for (int i = 0; i < threadCount; ++i) {
+        threads.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (std::thread& thread : threads) thread.join();
+}
+
+void ThreadPool::submit(Task task) {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    WorkQueue& queue = *queues[nextQueue];
+    nextQueue = (nextQueue + 1) % queues.size();
+    {
+        std::lock_guard<std::mutex> queueLock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+    queuedTasks++;
+    pendingTasks++;
+    workAvailable.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(stateMutex);
+    allDone.wait(lock, [this]() { return pendingTasks == 0; });
+}
+
+bool ThreadPool::popTask(int workerIndex, Task& task) {
+    // najpierw własna kolejka (od końca)
+    {
+        WorkQueue& own = *queues[workerIndex];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+    // potem kradzież z początku kolejek pozostałych wątków
+    for (size_t offset = 1; offset < queues.size(); ++offset) {
+        WorkQueue& victim = *queues[(workerIndex + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(int workerIndex) {
+    setTraceThreadName("pula wątków");
+    while (true) {
+        Task task;
+        if (popTask(workerIndex, task)) {
+            {
+                std::lock_guard<std::mutex> lock(stateMutex);
+                queuedTasks--;
+            }
+            task(workerIndex);
+
+            std::lock_guard<std::mutex> lock(stateMutex);
+            if (--pendingTasks == 0) allDone.notify_all();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(stateMutex);
+        if (!stopping && queuedTasks == 0) {
+            TraceScope parked("park", "threads");
+            workAvailable.wait(lock, [this]() { return stopping || queuedTasks > 0; });
+        }
+        if (stopping && queuedTasks == 0) return;
+    }
+}
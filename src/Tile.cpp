@@ -1,4 +1,4 @@
-#include "C:\Visual Studio\PiAA_proj3\include\Tile.hpp"
+#include "../include/Tile.hpp"
 
 Tile::Tile() : row(0), col(0), highlighted(false), piece(std::nullopt) {}
 
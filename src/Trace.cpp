@@ -0,0 +1,159 @@
+#include "../include/Trace.hpp"
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+std::atomic<bool> traceActive{false};
+
+namespace {
+
+struct TraceEvent {
+    const char* name;
+    const char* category;
+    const char* argName;
+    int64_t arg;
+    uint64_t start;
+    uint64_t duration;
+    char phase;  // 'X' - z czasem trwania, 'C' - licznik, 'i' - chwila
+};
+
+/*
+Bufor cykliczny jednego wątku: pisze tylko właściciel, więc wystarczy licznik zapisanych zdarzeń
+publikowany z release. Bufor przeżywa swój wątek - po jego końcu przejmuje go następny nowy wątek
+(wątki pul powstają przy każdym przeszukiwaniu, a liczba buforów zostaje ograniczona).
+*/
+struct TraceBuffer {
+    static const size_t CAPACITY = 1 << 15;
+
+    std::unique_ptr<TraceEvent[]> events{new TraceEvent[CAPACITY]};
+    std::atomic<uint64_t> written{0};
+    int id = 0;
+    std::string threadName;
+    bool inUse = true;
+
+    void push(const TraceEvent& event) {
+        uint64_t index = written.load(std::memory_order_relaxed);
+        events[index % CAPACITY] = event;
+        written.store(index + 1, std::memory_order_release);
+    }
+};
+
+std::mutex registryMutex;
+std::vector<std::unique_ptr<TraceBuffer>> buffers;
+std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+// bufor bieżącego wątku; przy końcu wątku wraca do puli wolnych
+struct ThreadTrace {
+    TraceBuffer* buffer = nullptr;
+
+    ~ThreadTrace() {
+        if (!buffer) return;
+        std::lock_guard<std::mutex> lock(registryMutex);
+        buffer->inUse = false;
+    }
+};
+
+thread_local ThreadTrace threadTrace;
+
+TraceBuffer& threadBuffer() {
+    if (threadTrace.buffer) return *threadTrace.buffer;
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (auto& buffer : buffers) {
+        if (!buffer->inUse) {
+            buffer->inUse = true;
+            buffer->threadName.clear();
+            threadTrace.buffer = buffer.get();
+            return *buffer;
+        }
+    }
+    buffers.push_back(std::make_unique<TraceBuffer>());
+    buffers.back()->id = static_cast<int>(buffers.size());
+    threadTrace.buffer = buffers.back().get();
+    return *threadTrace.buffer;
+}
+
+void writeString(std::ofstream& file, const char* text) {
+    file << '"';
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') file << '\\';
+        file << *c;
+    }
+    file << '"';
+}
+
+} // namespace
+
+void enableTrace(bool enabled) {
+    if (enabled && !traceEnabled()) epoch = std::chrono::steady_clock::now();
+    traceActive.store(enabled, std::memory_order_relaxed);
+}
+
+void clearTrace() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (auto& buffer : buffers) buffer->written.store(0, std::memory_order_relaxed);
+}
+
+void setTraceThreadName(const char* name) {
+    if (traceEnabled()) threadBuffer().threadName = name;
+}
+
+uint64_t traceNow() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+void traceComplete(const char* name, const char* category, uint64_t start, const char* argName, int64_t arg) {
+    threadBuffer().push({name, category, argName, arg, start, traceNow() - start, 'X'});
+}
+
+void traceCounter(const char* name, int64_t value) {
+    threadBuffer().push({name, "counter", "value", value, traceNow(), 0, 'C'});
+}
+
+void traceInstant(const char* name, const char* category) {
+    threadBuffer().push({name, category, nullptr, 0, traceNow(), 0, 'i'});
+}
+
+bool writeTrace(const std::string& path) {
+    std::ofstream file(path);
+    if (!file.is_open()) return false;
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    file << std::fixed << std::setprecision(3) << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    bool first = true;
+    for (const auto& buffer : buffers) {
+        uint64_t written = buffer->written.load(std::memory_order_acquire);
+        uint64_t begin = (written > TraceBuffer::CAPACITY) ? written - TraceBuffer::CAPACITY : 0;
+
+        file << (first ? "\n" : ",\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << buffer->id
+             << ", \"args\": {\"name\": ";
+        std::string name = buffer->threadName.empty() ? "wątek " + std::to_string(buffer->id) : buffer->threadName;
+        writeString(file, name.c_str());
+        file << "}}";
+        first = false;
+
+        for (uint64_t i = begin; i < written; ++i) {
+            const TraceEvent& event = buffer->events[i % TraceBuffer::CAPACITY];
+            // czas w mikrosekundach (wymóg formatu)
+            file << ",\n{\"name\": ";
+            writeString(file, event.name);
+            file << ", \"cat\": ";
+            writeString(file, event.category);
+            file << ", \"ph\": \"" << event.phase << "\", \"ts\": " << event.start / 1000.0
+                 << ", \"pid\": 1, \"tid\": " << buffer->id;
+            if (event.phase == 'X') file << ", \"dur\": " << event.duration / 1000.0;
+            if (event.phase == 'i') file << ", \"s\": \"t\"";
+            if (event.argName) {
+                file << ", \"args\": {";
+                writeString(file, event.argName);
+                file << ": " << event.arg << "}";
+            }
+            file << "}";
+        }
+    }
+    file << "\n]}\n";
+    return file.good();
+}
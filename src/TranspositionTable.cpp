@@ -0,0 +1,118 @@
+#include "../include/TranspositionTable.hpp"
+#include "../include/Trace.hpp"
+
+TranspositionTable::TranspositionTable(size_t megabytes) {
+    resize(megabytes);
+}
+
+void TranspositionTable::resize(size_t megabytes) {
+    TraceScope trace("TT resize", "tt", "MB", static_cast<int64_t>(megabytes));
+    size_t newCount = 1;
+    size_t maxCount = (megabytes * 1024 * 1024) / sizeof(TTBucket);
+    while (newCount * 2 <= maxCount) newCount *= 2;
+
+    buckets.reset(new TTBucket[newCount]);
+    count = newCount;
+    mask = count - 1;
+}
+
+void TranspositionTable::clear() {
+    TraceScope trace("TT clear", "tt");
+    for (size_t i = 0; i < count; ++i) {
+        for (TTSlot& slot : buckets[i].entries) {
+            slot.keyXorData.store(0, std::memory_order_relaxed);
+            slot.data.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+// dane: wynik (32 bity) | głębokość + 1 (8 bitów, 0 = pusty) | rodzaj wyniku | skąd | dokąd
+uint64_t TranspositionTable::pack(const TTEntry& entry) {
+    return static_cast<uint64_t>(static_cast<uint32_t>(entry.score))
+         | static_cast<uint64_t>(static_cast<uint8_t>(entry.depth + 1)) << 32
+         | static_cast<uint64_t>(entry.bound) << 40
+         | static_cast<uint64_t>(entry.moveFrom) << 48
+         | static_cast<uint64_t>(entry.moveTo) << 56;
+}
+
+TTEntry TranspositionTable::unpack(uint64_t key, uint64_t data) {
+    TTEntry entry;
+    entry.key = key;
+    entry.score = static_cast<int32_t>(static_cast<uint32_t>(data));
+    entry.depth = static_cast<int8_t>(static_cast<int>((data >> 32) & 0xFF) - 1);
+    entry.bound = static_cast<Bound>((data >> 40) & 0xFF);
+    entry.moveFrom = static_cast<uint8_t>(data >> 48);
+    entry.moveTo = static_cast<uint8_t>(data >> 56);
+    return entry;
+}
+
+bool TranspositionTable::read(const TTSlot& slot, uint64_t& key, TTEntry& entry) {
+    uint64_t data = slot.data.load(std::memory_order_relaxed);
+    key = slot.keyXorData.load(std::memory_order_relaxed) ^ data;
+    entry = unpack(key, data);
+    return entry.depth >= 0;
+}
+
+bool TranspositionTable::probe(uint64_t key, TTEntry& result) const {
+    const TTBucket& bucket = buckets[key & mask];
+    for (const TTSlot& slot : bucket.entries) {
+        uint64_t slotKey;
+        TTEntry entry;
+        if (read(slot, slotKey, entry) && slotKey == key) {
+            result = entry;
+            return true;
+        }
+    }
+    return false;
+}
+
+void TranspositionTable::store(uint64_t key, int depth, int score, Bound bound, int moveFrom, int moveTo) {
+    TTBucket& bucket = buckets[key & mask];
+
+    TTEntry newEntry;
+    newEntry.key = key;
+    newEntry.score = score;
+    newEntry.depth = static_cast<int8_t>(depth);
+    newEntry.bound = bound;
+    newEntry.moveFrom = static_cast<uint8_t>(moveFrom);
+    newEntry.moveTo = static_cast<uint8_t>(moveTo);
+
+    // aktualna zawartość kubełka (pusty albo rozerwany wpis ma głębokość -1)
+    TTEntry entries[TTBucket::DEPTH_SLOTS + 1];
+    uint64_t keys[TTBucket::DEPTH_SLOTS + 1];
+    for (int i = 0; i <= TTBucket::DEPTH_SLOTS; ++i) {
+        if (!read(bucket.entries[i], keys[i], entries[i])) entries[i].depth = -1;
+    }
+
+    // ta sama pozycja - nadpisujemy, chyba że stary wpis jest głębszy
+    int victim = -1;
+    for (int i = 0; i <= TTBucket::DEPTH_SLOTS; ++i) {
+        if (entries[i].depth >= 0 && keys[i] == key) {
+            if (depth < entries[i].depth && bound != Bound::Exact) return;
+            if (!newEntry.hasMove()) {
+                newEntry.moveFrom = entries[i].moveFrom;
+                newEntry.moveTo = entries[i].moveTo;
+            }
+            victim = i;
+            break;
+        }
+    }
+
+    // najpłytszy z wpisów depth-preferred, a jeśli nowy jest płytszy - wpis always-replace
+    if (victim < 0) {
+        victim = 0;
+        for (int i = 1; i < TTBucket::DEPTH_SLOTS; ++i) {
+            if (entries[i].depth < entries[victim].depth) victim = i;
+        }
+        if (depth < entries[victim].depth) victim = TTBucket::DEPTH_SLOTS;
+    }
+
+    uint64_t data = pack(newEntry);
+    TTSlot& slot = bucket.entries[victim];
+    slot.keyXorData.store(key ^ data, std::memory_order_relaxed);
+    slot.data.store(data, std::memory_order_relaxed);
+}
+
+size_t TranspositionTable::getSizeInMB() const {
+    return count * sizeof(TTBucket) / (1024 * 1024);
+}
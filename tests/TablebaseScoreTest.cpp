@@ -0,0 +1,66 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../include/AI.hpp"
+#include "../include/Notation.hpp"
+
+/*
+Wygrana z bazy końcówek i wygrana znaleziona przeszukiwaniem muszą być na jednej skali (winIn/lossIn):
+krótsza wygrana wygrywa niezależnie od źródła.
+Pozycja: czarne wygrywają przeszukiwaniem w 5 ply (26x12), a bicie 27x20 prowadzi do składu, który
+sztuczna baza (jeden skład, każda pozycja: strona na ruchu przegrywa w 2 ply) ocenia jako wygraną w 3 ply.
+*/
+
+namespace {
+
+const char* POSITION = "B:W24,K19:BK27,K6,K26";
+const int DEPTH = 9;
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    std::cout << (condition ? "OK   " : "BŁĄD ") << what << std::endl;
+    if (!condition) failures++;
+}
+
+SearchResult search(const Bitboard& board) {
+    aiTranspositionTable().clear();
+    SearchLimits limits;
+    limits.maxDepth = DEPTH;
+    return searchBestMove(board, limits);
+}
+
+} // namespace
+
+int main() {
+    Bitboard board;
+    if (!parsePosition(POSITION, board)) {
+        std::cout << "BŁĄD zapis pozycji " << POSITION << std::endl;
+        return 1;
+    }
+
+    endgameTablebase().open("", 0);
+    SearchResult searched = search(board);
+    check(formatMove(searched.bestMove) == "26x12" && searched.score == winIn(5),
+          "bez bazy: " + formatMove(searched.bestMove) + ", ocena " + std::to_string(searched.score));
+
+    // składu po 27x20 (białe na ruchu) nie ma po drodze do wygranej 26x12
+    Move intoTablebase;
+    for (const Move& move : board.getAllValidMoves(Piececolor::Black)) {
+        if (formatMove(move) == "27x20") intoTablebase = move;
+    }
+    Bitboard child = board;
+    child.applyMove(intoTablebase);
+    MaterialSignature signature = normalizePosition(child, Piececolor::White).signature();
+
+    endgameTablebase().open("", 4);
+    endgameTablebase().install(signature, std::vector<uint8_t>(tablebaseSize(signature), tbEncodeDistance(2)));
+    SearchResult probed = search(board);
+    check(formatMove(probed.bestMove) == "27x20" && probed.score == winIn(3),
+          "z bazą: " + formatMove(probed.bestMove) + ", ocena " + std::to_string(probed.score));
+    check(isGameEndScore(probed.score) && probed.stats.depth() < DEPTH,
+          "wygrana z bazy kończy pogłębianie na głębokości " + std::to_string(probed.stats.depth()));
+
+    endgameTablebase().open("", 0);
+    return failures == 0 ? 0 : 1;
+}
@@ -3,9 +3,11 @@
 #include <algorithm>
 #include <vector>
 #include <optional>
-#include <chrono>
+#include <iomanip>
 #include "../include/Board.hpp"
 #include "../include/AI.hpp"
+#include "../include/AIWorker.hpp"
+#include "../include/Notation.hpp"
 
 const int BOARD_SIZE = 8;
 const int SPRITE_SIZE = 16; 
@@ -27,7 +29,39 @@ std::vector<Move> getPossibleMoves(int startCol, int startRow, Board& board, Pie
 }
 
 bool isGameOver(Board& board, Piececolor player) {
-    return board.getAllValidMoves(player).empty();
+    return !board.hasAnyMove(player);
+}
+
+// podsumowanie przeszukiwania AI w konsoli
+void printSearchStats(const SearchResult& result) {
+    const SearchStats& stats = result.stats;
+    std::cout << "AI: " << formatMove(result.bestMove) << ", ocena " << result.score;
+    if (isGameEndScore(result.score)) {
+        std::cout << (result.score > 0 ? " (wygrana za " : " (przegrana za ") << WIN_SCORE - std::abs(result.score) << " ply)";
+    }
+    std::cout << ", głębokość " << stats.depth() << "/" << stats.maxSelectiveDepth
+              << ", " << std::fixed << std::setprecision(0) << stats.timeMs << " ms, wątki: " << stats.threads
+              << std::endl;
+    std::cout << "  węzły: " << stats.nodes << " (spoczynkowe " << stats.quiescenceNodes << "), "
+              << stats.nodesPerSecond() / 1000.0 << " kN/s, oceny: " << stats.evaluations
+              << ", generowanie ruchów: " << stats.moveGenerations << std::endl;
+    std::cout << "  TT: " << stats.ttProbes << " sond, " << std::setprecision(1) << stats.ttHitRate() * 100
+              << "% trafień, " << stats.ttCutoffs << " cięć; baza końcówek: " << stats.tablebaseHits << std::endl;
+    const OrderingStats& ordering = stats.ordering;
+    std::cout << "  cięcia beta: " << ordering.betaCutoffs << " (pierwszy ruch " << ordering.firstMoveCutoffRate() * 100
+              << "%), wg etapu:";
+    for (int stage = 0; stage < PICK_STAGE_COUNT; ++stage) {
+        std::cout << " " << pickStageName(static_cast<PickStage>(stage)) << " " << ordering.cutoffsByStage[stage];
+    }
+    std::cout << ", wg indeksu ruchu:";
+    for (uint64_t count : ordering.cutoffsByMoveIndex) std::cout << " " << count;
+    std::cout << std::endl << "  iteracje (ms):";
+    for (const SearchIteration& iteration : stats.iterations) {
+        std::cout << " " << iteration.depth << ":" << std::setprecision(0) << iteration.elapsedMs;
+    }
+    std::cout << std::endl << "  wariant:";
+    for (const Move& move : result.principalVariation) std::cout << " " << formatMove(move);
+    std::cout << std::endl;
 }
 
 enum class ScreenState { Start, Game, GameOver, Options };
@@ -45,6 +79,9 @@ CheckerAnimation checkerAnim;
 sf::Clock animClock;
 
 int aiDepth = 2;
+int aiTimeLimitMs = 0; // 0 - bez limitu czasu (stała głębokość)
+const int HARD_AI_TIME_MS = 1000;
+int aiThreads = 1; // wątki przeszukiwania (Hard - wszystkie rdzenie, Lazy SMP)
 int gameMode = 2; // 1 — PvP, 2 — PvE
 
 int main() {
@@ -67,6 +104,11 @@ int main() {
     }
     checkersTexture.setSmooth(false);
 
+    // bazy końcówek z TablebaseGen (jeśli są) - każdy skład wczytywany przy pierwszej sondzie
+    endgameTablebase().open("../tablebase", TB_MAX_PIECES);
+    // książka debiutowa z OpeningBookGen (jeśli jest) - pierwsze ruchy AI bez przeszukiwania
+    openingBook().open("../opening_book.bin");
+
     sf::Sprite boardSprite(boardTexture);
 
     sf::IntRect whiteRect     ({0 * SPRITE_SIZE, 0}, {SPRITE_SIZE, SPRITE_SIZE});
@@ -104,6 +146,9 @@ int main() {
     sf::Vector2i joySelectedCell(0, 0); 
     bool joyHadInput = false;
 
+    // AI liczy w osobnym wątku, okno rysuje się dalej
+    AIWorker aiWorker;
+
     while (window.isOpen()) {
         std::optional<sf::Event> optEvent;
         while (optEvent = window.pollEvent()) {
@@ -143,7 +188,7 @@ int main() {
                     }
                 }
 
-                if (screenState == ScreenState::Game) {
+                if (screenState == ScreenState::Game && !(gameMode == 2 && currentPlayer == Piececolor::Black)) {
                     if (sf::Joystick::isButtonPressed(0, 1) && !joyHadInput) {
                         joyHadInput = true;
                         if (screenState == ScreenState::Game) {
@@ -186,22 +231,8 @@ int main() {
                                                 }
                                                 
                                                 if (gameMode == 2 && currentPlayer == Piececolor::Black) {
-                                                    std::vector<Move> aiMoves = board.getAllValidMoves(Piececolor::Black);
-                                                    if (!aiMoves.empty()) {
-                                                        auto start = std::chrono::high_resolution_clock::now();
-                                                        Move aiMove = findBestMove(board, aiDepth);
-                                                        auto end = std::chrono::high_resolution_clock::now();
-                                                        std::cout << "AI move time: " << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms\n";
-                                                        board.applyMove(aiMove);
-                                                        std::cout << "Board evaluation: " << evaluateBoard(board) << std::endl;
-                                                        currentPlayer = Piececolor::White;
-                                                        selectedCellOpt = std::nullopt;
-                                                        
-                                                        if (isGameOver(board, currentPlayer)) {
-                                                            gameOver = true;
-                                                            gameOverText = (currentPlayer == Piececolor::White) ? "Black wins!" : "White wins!";
-                                                            screenState = ScreenState::GameOver;
-                                                        }
+                                                    if (board.hasAnyMove(Piececolor::Black)) {
+                                                        aiWorker.start(board.getBitboard(), aiDepth, aiTimeLimitMs, aiThreads);
                                                     }
                                                 }
                                             }
@@ -254,6 +285,7 @@ int main() {
                         sf::Vector2i mousePos = mouseButtonPressed->position;
                         // Start Game
                         if (mousePos.y > 200 && mousePos.y < 260) {
+                            aiWorker.cancel();
                             board.initialize();
                             currentPlayer = Piececolor::White;
                             selectedCellOpt = std::nullopt;
@@ -295,16 +327,8 @@ int main() {
                                     if (clickedCol == selCol && clickedRow == selRow) {
                                         selectedCellOpt = std::nullopt;
                                         if (gameMode == 2 && currentPlayer == Piececolor::Black && !selectedCellOpt.has_value()) {
-                                            std::vector<Move> aiMoves = board.getAllValidMoves(Piececolor::Black);
-                                            if (!aiMoves.empty()) {
-                                                auto start = std::chrono::high_resolution_clock::now();
-                                                Move aiMove = findBestMove(board, aiDepth); 
-                                                auto end = std::chrono::high_resolution_clock::now();
-                                                std::cout << "AI move time: " << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms\n";
-                                                board.applyMove(aiMove);
-                                                std::cout << "Board evaluation: " << evaluateBoard(board) << std::endl;
-                                                currentPlayer = Piececolor::White;
-                                                selectedCellOpt = std::nullopt;
+                                            if (board.hasAnyMove(Piececolor::Black)) {
+                                                aiWorker.start(board.getBitboard(), aiDepth, aiTimeLimitMs, aiThreads);
                                             }
                                         }
                                     } else {
@@ -342,22 +366,8 @@ int main() {
                                                     }
 
                                                     if (gameMode == 2 && currentPlayer == Piececolor::Black) {
-                                                        std::vector<Move> aiMoves = board.getAllValidMoves(Piececolor::Black);
-                                                        if (!aiMoves.empty()) {
-                                                            auto start = std::chrono::high_resolution_clock::now();
-                                                            Move aiMove = findBestMove(board, aiDepth); // 
-                                                            auto end = std::chrono::high_resolution_clock::now();
-                                                            std::cout << "AI move time: " << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms\n";
-                                                            board.applyMove(aiMove);
-                                                            std::cout << "Board evaluation: " << evaluateBoard(board) << std::endl;
-                                                            currentPlayer = Piececolor::White;
-                                                            selectedCellOpt = std::nullopt;
-
-                                                            if (isGameOver(board, currentPlayer)) {
-                                                                gameOver = true;
-                                                                gameOverText = (currentPlayer == Piececolor::White) ? "Black wins!" : "White wins!";
-                                                                screenState = ScreenState::GameOver;
-                                                            }
+                                                        if (board.hasAnyMove(Piececolor::Black)) {
+                                                            aiWorker.start(board.getBitboard(), aiDepth, aiTimeLimitMs, aiThreads);
                                                         }
                                                     }
                                                 }
@@ -386,6 +396,7 @@ int main() {
 
                 if (auto* keyPressed = event.getIf<sf::Event::KeyPressed>()) {
                     if (keyPressed->scancode == sf::Keyboard::Scan::Escape) {
+                        aiWorker.cancel();
                         screenState = ScreenState::Start;
                         continue;
                     }
@@ -510,12 +521,16 @@ int main() {
                         sf::Vector2f(easyBounds.size.x, easyBounds.size.y))
                             .contains(sf::Vector2f(mousePos))) {
                             aiDepth = 3;
+                            aiTimeLimitMs = 0;
+                            aiThreads = 1;
                         }
                         // Hard AI
                         if (sf::FloatRect(sf::Vector2f(WINDOW_SIZE/2 - hardBounds.size.x/2, 250 - hardBounds.size.y/2), 
                             sf::Vector2f(hardBounds.size.x, hardBounds.size.y))
                             .contains(sf::Vector2f(mousePos))) {
-                            aiDepth = 9;
+                            aiDepth = MAX_SEARCH_DEPTH;
+                            aiTimeLimitMs = HARD_AI_TIME_MS;
+                            aiThreads = defaultSearchThreads();
                         }
                         // PvP
                         if (sf::FloatRect(sf::Vector2f(WINDOW_SIZE/2 - pvpBounds.size.x/2, 300 - pvpBounds.size.y/2), 
@@ -540,6 +555,21 @@ int main() {
             }
         }
 
+        // ruch AI liczony w tle - co klatkę sprawdzamy, czy jest już gotowy
+        if (std::optional<SearchResult> aiResult = aiWorker.poll()) {
+            printSearchStats(*aiResult);
+            board.applyMove(aiResult->bestMove);
+            std::cout << "Board evaluation: " << evaluateBoard(board) << std::endl;
+            currentPlayer = Piececolor::White;
+            selectedCellOpt = std::nullopt;
+
+            if (isGameOver(board, currentPlayer)) {
+                gameOver = true;
+                gameOverText = (currentPlayer == Piececolor::White) ? "Black wins!" : "White wins!";
+                screenState = ScreenState::GameOver;
+            }
+        }
+
         window.clear();
 
         if (screenState == ScreenState::Start) {
@@ -774,7 +804,7 @@ int main() {
             window.draw(easy);
 
             sf::Text hard(font, "Hard AI", 32);
-            if (aiDepth == 9) hard.setFillColor(sf::Color(255, 255, 128));
+            if (aiTimeLimitMs > 0) hard.setFillColor(sf::Color(255, 255, 128));
             else hard.setFillColor(sf::Color(234, 240, 216));
             hardBounds = hard.getLocalBounds();
             hard.setOrigin(sf::Vector2f(hardBounds.position.x + hardBounds.size.x / 2, hardBounds.position.y + hardBounds.size.y / 2));